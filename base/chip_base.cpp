@@ -26,13 +26,21 @@ chip_base::~chip_base() { }
 gpio::pin* chip_base::pin(gpio::pos n)
 {
     throw_range(n);
+    if(!pins_[n]) pins_[n] = make_pin(n);
     return pins_[n].get();
 }
 
 const gpio::pin* chip_base::pin(gpio::pos n) const
 {
-    throw_range(n);
-    return pins_[n].get();
+    return const_cast<chip_base*>(this)->pin(n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void chip_base::watch(const std::vector<gpio::pos>&, gpio::flag)
+{
+    throw std::invalid_argument(
+        type_id(this) + ": Cannot watch pins - Ordered pin events not supported"
+    );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
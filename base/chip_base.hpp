@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -44,14 +45,38 @@ public:
     virtual gpio::pin* pin(gpio::pos) override;
     virtual const gpio::pin* pin(gpio::pos) const override;
 
+    ////////////////////
+    virtual unique_group group(std::vector<gpio::pos> pos, gpio::mode mode, gpio::flag flags) override
+    { return group(std::move(pos), mode, flags, 0); }
+    virtual unique_group group(std::vector<gpio::pos> pos, gpio::mode mode, mask value) override
+    { return group(std::move(pos), mode, gpio::flag { }, value); }
+    virtual unique_group group(std::vector<gpio::pos> pos, gpio::mode mode) override
+    { return group(std::move(pos), mode, gpio::flag { }); }
+    using chip::group;
+
+    ////////////////////
+    virtual void timing(const gpio::timing& timing) override { timing_ = timing; }
+    virtual const gpio::timing& timing() const noexcept override { return timing_; }
+
+    ////////////////////
+    // set pins as inputs sharing one event stream, so that
+    // events of all pins are received in order (see encoder);
+    // backends that can't do it throw std::invalid_argument
+    virtual void watch(const std::vector<gpio::pos>&, gpio::flag);
+
 protected:
     ////////////////////
     std::string type_, id_;
     std::string name_;
 
+    // pins are created on first access (see make_pin)
     using unique_pin = std::unique_ptr<gpio::pin>;
     std::vector<unique_pin> pins_;
 
+    virtual unique_pin make_pin(gpio::pos) = 0;
+
+    gpio::timing timing_;
+
     void throw_range(gpio::pos) const;
 };
 
@@ -0,0 +1,141 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip_base.hpp"
+#include "type_id.hpp"
+
+#include <gpio++/encoder.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// both pins changed (can't happen, as each event changes one pin)
+constexpr std::int8_t X = 2;
+
+// steps further apart start a new velocity window
+constexpr nsec stopped = 1s;
+
+// step for each transition indexed by (prev state << 2 | state),
+// where state is A << 1 | B and A leads B going forward:
+// 00 -> 10 -> 11 -> 01 -> 00
+constexpr std::int8_t steps[16] =
+{
+//  00  01  10  11     <- state
+     0, -1, +1,  X, // 00 prev state
+    +1,  0,  X, -1, // 01
+    -1,  X,  0, +1, // 10
+     X, +1, -1,  0, // 11
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+encoder::encoder(gpio::chip* chip, gpio::pos a, gpio::pos b, gpio::flag flags, nsec window) :
+    a_(chip->pin(a)), b_(chip->pin(b)), window_(std::max(window, 1ns))
+{
+    // request both pins together, so that their events are received in order
+    // (pins set up one at a time could end up with separate event streams)
+    auto base = dynamic_cast<chip_base*>(chip);
+    if(!base) throw std::invalid_argument(
+        type_id(chip) + ": Cannot create encoder - Ordered pin events not supported"
+    );
+    base->watch({ a, b }, flags);
+
+    state_ = (a_->state() ? 2u : 0u) | (b_->state() ? 1u : 0u);
+
+    a_id_ = a_->on_events([&](events ev){ decode(2, ev); });
+    b_id_ = b_->on_events([&](events ev){ decode(1, ev); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+encoder::~encoder()
+{
+    try
+    {
+        a_->remove(a_id_);
+        b_->remove(b_id_);
+    }
+    catch(...) { }
+
+    try { a_->detach(); } catch(...) { }
+    try { b_->detach(); } catch(...) { }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double encoder::velocity() const noexcept
+{
+    auto vel = vel_.load(std::memory_order_relaxed);
+    if(vel != 0)
+    {
+        // stopped: no steps for two windows
+        // (or two steps at the last velocity)
+        auto last = timestamp(nsec(last_.load(std::memory_order_relaxed)));
+        auto quiet = std::max(2 * window_, nsec(static_cast<nsec::rep>(2e9 / std::abs(vel))));
+        if(std::chrono::steady_clock::now() - last > quiet) vel = 0;
+    }
+    return vel;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void encoder::decode(unsigned bit, events ev)
+{
+    std::int64_t delta = 0;
+    std::uint64_t invalid = 0;
+
+    for(const auto& e : ev)
+    {
+        auto state = e.state ? (state_ | bit) : (state_ & ~bit);
+
+        // same level twice: the edge in between was lost
+        // (its steps would have cancelled out)
+        if(state == state_) { ++invalid; continue; }
+
+        auto step = steps[state_ << 2 | state];
+        state_ = state;
+
+        if(step == X) { ++invalid; continue; }
+
+        delta += step;
+
+        if(e.time - time_ > stopped)
+        {
+            steps_ = 0;
+            time0_ = e.time;
+        }
+        else
+        {
+            steps_ += step;
+            if(e.time - time0_ >= window_)
+            {
+                vel_.store(steps_ * 1e9 / static_cast<double>((e.time - time0_).count()),
+                    std::memory_order_relaxed
+                );
+                steps_ = 0;
+                time0_ = e.time;
+            }
+        }
+
+        time_ = e.time;
+        last_.store(e.time.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    if(delta) pos_.fetch_add(delta, std::memory_order_relaxed);
+    if(invalid) invalid_.fetch_add(invalid, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "group_base.hpp"
+#include "timing.hpp"
+#include "type_id.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+group_base::group_base(asio::io_service& io, gpio::chip* chip, std::vector<gpio::pos> pos) :
+    io_(io), chip_(chip), pos_(std::move(pos))
+{
+    if(pos_.empty() || pos_.size() > 8 * sizeof(mask)) throw std::invalid_argument(
+        type_id(chip_) + ": Invalid group size " + std::to_string(pos_.size())
+    );
+
+    for(auto n : pos_)
+    {
+        if(n >= chip_->pin_count()) throw std::out_of_range(
+            type_id(chip_) + ": Invalid pin # " + std::to_string(n)
+        );
+
+        if(std::count(pos_.begin(), pos_.end(), n) > 1) throw std::invalid_argument(
+            type_id(chip_) + ": Duplicate pin # " + std::to_string(n)
+        );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+group_base::~group_base() { stop(); }
+
+////////////////////////////////////////////////////////////////////////////////
+gpio::pos group_base::pos(std::size_t n) const
+{
+    if(n >= pos_.size()) throw std::out_of_range(
+        type_id(this) + ": Invalid index " + std::to_string(n)
+    );
+    return pos_[n];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void group_base::play(gpio::wave wave, std::size_t repeat, fn_done fn)
+{
+    if(!repeat && wave.duration() == 0ns) throw std::invalid_argument(
+        type_id(this) + ": Cannot play wave - Zero duration wave repeated forever"
+    );
+
+    stop();
+
+    stop_ = false;
+    playing_ = true;
+
+    // start playing once timing options have been applied
+    std::promise<bool> start;
+    auto started = start.get_future();
+
+    auto timing = chip_->timing();
+    player_ = std::thread([this, wave = std::move(wave), repeat, fn = std::move(fn),
+        timing, started = std::move(started)]() mutable
+    {
+        if(!started.get())
+        {
+            playing_ = false;
+            return;
+        }
+
+        bool done = false;
+        try
+        {
+            auto tp = std::chrono::steady_clock::now();
+            for(std::size_t n = 0; !repeat || n < repeat; ++n)
+            {
+                for(const auto& wr : wave.writes())
+                {
+                    wait_until(tp + wr.time, timing);
+                    if(stop_) break;
+
+                    set(wr.values, wr.lines);
+                }
+                if(stop_) break;
+
+                // start next round exactly one duration later
+                tp += wave.duration();
+                wait_until(tp, timing);
+            }
+            done = !stop_;
+        }
+        // NB: completion is not reported, if a write fails
+        catch(...) { }
+
+        playing_ = false;
+        if(done && fn) io_.post(fn);
+    });
+
+    try { apply(player_, timing); }
+    catch(...)
+    {
+        start.set_value(false);
+        player_.join();
+        throw;
+    }
+    start.set_value(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void group_base::stop()
+{
+    if(player_.joinable())
+    {
+        stop_ = true;
+        player_.join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+mask group_base::all() const noexcept
+{
+    return pos_.size() < 64 ? (mask { 1 } << pos_.size()) - 1 : ~mask { 0 };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GROUP_BASE_HPP
+#define GPIO_GROUP_BASE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/group.hpp>
+#include <gpio++/types.hpp>
+#include <gpio++/wave.hpp>
+
+#include <asio/io_service.hpp>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class group_base : public group
+{
+public:
+    ////////////////////
+    group_base(asio::io_service&, gpio::chip*, std::vector<gpio::pos>);
+    virtual ~group_base() override;
+
+    group_base(const group_base&) = delete;
+    group_base& operator=(const group_base&) = delete;
+
+    ////////////////////
+    virtual const gpio::chip* chip() const noexcept override { return chip_; }
+
+    virtual std::size_t size() const noexcept override { return pos_.size(); }
+    virtual gpio::pos pos(std::size_t) const override;
+
+    ////////////////////
+    virtual gpio::mode mode() const noexcept override { return mode_; }
+    virtual bool is(gpio::flag flag) const noexcept override { return flags_ & flag; }
+
+    ////////////////////
+    virtual void set(mask value) override { set(value, all()); }
+    using group::set;
+
+    ////////////////////
+    virtual void play(gpio::wave, std::size_t repeat = 1, fn_done = nullptr) override;
+    virtual void stop() override;
+    virtual bool is_playing() const noexcept override { return playing_; }
+
+protected:
+    ////////////////////
+    asio::io_service& io_;
+    gpio::chip* chip_ = nullptr;
+    std::vector<gpio::pos> pos_;
+
+    gpio::mode mode_ = detached;
+    gpio::flag flags_ { };
+
+    // mask of all pins in the group
+    mask all() const noexcept;
+
+    // NB: derived classes must call stop() in their dtor
+    std::thread player_;
+    std::atomic<bool> stop_ { false }, playing_ { false };
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
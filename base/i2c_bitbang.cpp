@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "timing.hpp"
+#include "type_id.hpp"
+#include "worker.hpp"
+
+#include <gpio++/i2c.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+using clock = std::chrono::steady_clock;
+
+constexpr mask sda_bit = 0b01, scl_bit = 0b10;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+i2c_bitbang::i2c_bitbang(gpio::chip* chip, gpio::pos sda, gpio::pos scl,
+    unsigned hz, gpio::flag flags
+) :
+    lines_(chip->group({ sda, scl }, out,
+        static_cast<gpio::flag>(flags | open_drain), sda_bit | scl_bit
+    )),
+    worker_(std::make_unique<worker>(chip->timing())),
+    timing_(chip->timing()),
+    half_(hz ? nsec { 500000000 / hz } : 0ns)
+{ }
+
+i2c_bitbang::~i2c_bitbang() { }
+
+////////////////////////////////////////////////////////////////////////////////
+void i2c_bitbang::write(std::uint8_t addr, const std::vector<std::uint8_t>& data)
+{
+    transfer(addr, data, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::uint8_t> i2c_bitbang::read(std::uint8_t addr, std::size_t size)
+{
+    return transfer(addr, { }, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::uint8_t> i2c_bitbang::transfer(std::uint8_t addr,
+    const std::vector<std::uint8_t>& data, std::size_t size
+)
+{
+    return worker_->run([&]()
+    {
+        if(data.size())
+        {
+            address(addr, false);
+            for(auto byte : data)
+                if(!write_byte(byte))
+                {
+                    stop();
+                    throw std::runtime_error(
+                        type_id(lines_.get()) + ": Cannot write to device " + std::to_string(addr) + " - No ACK"
+                    );
+                }
+        }
+
+        std::vector<std::uint8_t> rx;
+        if(size)
+        {
+            address(addr, true); // repeated start
+            for(; size; --size) rx.push_back(read_byte(size > 1));
+        }
+
+        stop();
+        return rx;
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool i2c_bitbang::probe(std::uint8_t addr)
+{
+    return worker_->run([&]()
+    {
+        start();
+        bool ack = write_byte(static_cast<std::uint8_t>(addr << 1));
+        stop();
+        return ack;
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void i2c_bitbang::delay() { wait_until(clock::now() + half_, timing_); }
+
+////////////////////////////////////////////////////////////////////////////////
+void i2c_bitbang::scl_release()
+{
+    lines_->set(scl_bit, scl_bit);
+
+    // clock stretching
+    auto timeout = clock::now() + stretch_;
+    while(!(lines_->state() & scl_bit))
+        if(clock::now() > timeout) throw std::runtime_error(
+            type_id(lines_.get()) + ": Clock stretching timeout"
+        );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void i2c_bitbang::start()
+{
+    // also serves as repeated start
+    lines_->set(sda_bit, sda_bit);
+    scl_release();
+    delay();
+
+    lines_->set(0, sda_bit);
+    delay();
+    lines_->set(0, scl_bit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void i2c_bitbang::stop()
+{
+    lines_->set(0, sda_bit);
+    delay();
+    scl_release();
+    delay();
+    lines_->set(sda_bit, sda_bit);
+    delay();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void i2c_bitbang::write_bit(bool bit)
+{
+    lines_->set(bit ? sda_bit : 0, sda_bit);
+    delay();
+    scl_release();
+    delay();
+    lines_->set(0, scl_bit);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool i2c_bitbang::read_bit()
+{
+    lines_->set(sda_bit, sda_bit);
+    delay();
+    scl_release();
+    delay();
+    bool bit = lines_->state() & sda_bit;
+    lines_->set(0, scl_bit);
+    return bit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool i2c_bitbang::write_byte(std::uint8_t byte)
+{
+    for(int n = 7; n >= 0; --n) write_bit(byte & (1 << n));
+    return !read_bit(); // ack
+}
+
+std::uint8_t i2c_bitbang::read_byte(bool ack)
+{
+    std::uint8_t byte = 0;
+    for(int n = 7; n >= 0; --n) if(read_bit()) byte |= 1 << n;
+    write_bit(!ack);
+    return byte;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void i2c_bitbang::address(std::uint8_t addr, bool read)
+{
+    start();
+    if(!write_byte(static_cast<std::uint8_t>(addr << 1 | read)))
+    {
+        stop();
+        throw std::runtime_error(
+            type_id(lines_.get()) + ": Device " + std::to_string(addr) + " not responding"
+        );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
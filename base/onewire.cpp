@@ -0,0 +1,194 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "timing.hpp"
+#include "worker.hpp"
+
+#include <gpio++/onewire.hpp>
+
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+using namespace std::chrono_literals;
+using clock = std::chrono::steady_clock;
+
+// standard speed timing
+constexpr nsec reset_low = 480us, presence = 70us, reset_high = 410us;
+constexpr nsec write_0_low = 60us, write_1_low = 6us, slot = 70us;
+constexpr nsec read_low = 6us, read_sample = 15us;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+onewire::onewire(gpio::chip* chip, gpio::pos n, gpio::flag flags) :
+    line_(chip->group({ n }, out, static_cast<gpio::flag>(flags | open_drain), 1)),
+    worker_(std::make_unique<worker>(chip->timing())),
+    timing_(chip->timing())
+{ }
+
+onewire::~onewire() { }
+
+////////////////////////////////////////////////////////////////////////////////
+bool onewire::reset() { return worker_->run([&](){ return reset_(); }); }
+
+////////////////////////////////////////////////////////////////////////////////
+void onewire::write(const std::vector<std::uint8_t>& data)
+{
+    worker_->run([&](){ for(auto byte : data) write_byte(byte); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::uint8_t> onewire::read(std::size_t size)
+{
+    return worker_->run([&]()
+    {
+        std::vector<std::uint8_t> data;
+        for(; size; --size) data.push_back(read_byte());
+        return data;
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void onewire::select(rom code)
+{
+    worker_->run([&]()
+    {
+        write_byte(0x55);
+        for(int n = 0; n < 8; ++n) write_byte(static_cast<std::uint8_t>(code >> (8 * n)));
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void onewire::skip() { worker_->run([&](){ write_byte(0xcc); }); }
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<onewire::rom> onewire::search()
+{
+    return worker_->run([&]()
+    {
+        std::vector<rom> roms;
+
+        rom code = 0;
+        int last = -1; // last discrepancy
+
+        do
+        {
+            if(!reset_()) break;
+            write_byte(0xf0);
+
+            int discrepancy = -1;
+            for(int n = 0; n < 64; ++n)
+            {
+                bool bit = read_bit(), cmp = read_bit();
+                if(bit && cmp) return roms; // no devices
+
+                if(bit == cmp) // conflict
+                {
+                    if(n < last) bit = code & (rom { 1 } << n);
+                    else bit = n == last;
+
+                    if(!bit) discrepancy = n;
+                }
+
+                if(bit) code |= rom { 1 } << n;
+                else code &= ~(rom { 1 } << n);
+
+                write_bit(bit);
+            }
+
+            std::uint8_t bytes[8];
+            for(int n = 0; n < 8; ++n) bytes[n] = static_cast<std::uint8_t>(code >> (8 * n));
+            if(!crc8(bytes, 8)) roms.push_back(code);
+
+            last = discrepancy;
+        }
+        while(last >= 0);
+
+        return roms;
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint8_t onewire::crc8(const std::uint8_t* data, std::size_t size) noexcept
+{
+    std::uint8_t crc = 0;
+    for(; size; --size, ++data)
+    {
+        crc ^= *data;
+        for(int n = 0; n < 8; ++n) crc = (crc & 1) ? (crc >> 1) ^ 0x8c : crc >> 1;
+    }
+    return crc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool onewire::reset_()
+{
+    auto tp = clock::now();
+
+    line_->set(0);
+    wait_until(tp += reset_low, timing_);
+
+    line_->set(1);
+    wait_until(tp + presence, timing_);
+
+    bool present = !line_->state();
+    wait_until(tp + presence + reset_high, timing_);
+
+    return present;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void onewire::write_bit(bool bit)
+{
+    auto tp = clock::now();
+
+    line_->set(0);
+    wait_until(tp + (bit ? write_1_low : write_0_low), timing_);
+
+    line_->set(1);
+    wait_until(tp + slot, timing_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool onewire::read_bit()
+{
+    auto tp = clock::now();
+
+    line_->set(0);
+    wait_until(tp + read_low, timing_);
+
+    line_->set(1);
+    wait_until(tp + read_sample, timing_);
+
+    bool bit = line_->state();
+    wait_until(tp + slot, timing_);
+
+    return bit;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void onewire::write_byte(std::uint8_t byte)
+{
+    for(int n = 0; n < 8; ++n) write_bit(byte & (1 << n));
+}
+
+std::uint8_t onewire::read_byte()
+{
+    std::uint8_t byte = 0;
+    for(int n = 0; n < 8; ++n) if(read_bit()) byte |= 1 << n;
+    return byte;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -7,8 +7,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "chip_base.hpp"
 #include "pin_base.hpp"
+#include "type_id.hpp"
 
 #include <algorithm>
+#include <stdexcept>
 #include <utility>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -16,8 +18,8 @@ namespace gpio
 {
 
 ////////////////////////////////////////////////////////////////////////////////
-pin_base::pin_base(gpio::chip* chip, gpio::pos n) noexcept :
-    chip_(chip), pos_(n)
+pin_base::pin_base(asio::io_service& io, gpio::chip* chip, gpio::pos n) noexcept :
+    io_(io), chip_(chip), pos_(n)
 { }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -65,6 +67,17 @@ percent pin_base::duty_cycle() const noexcept
     return 100_pc * pulse_.count() / period_.count();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::throw_error(const std::string& what, const std::error_code& ec) const
+{
+    if(ec == detached_error() && is_detached()) throw std::logic_error(
+        type_id(this) + ": " + what + " - Detached instance"
+    );
+    throw std::runtime_error(
+        type_id(this) + ": " + what + " - " + ec.message()
+    );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 cid pin_base::on_state_changed(fn_state_changed fn)
 {
@@ -74,25 +87,272 @@ cid pin_base::on_state_changed(fn_state_changed fn)
 ////////////////////////////////////////////////////////////////////////////////
 cid pin_base::on_state_on(fn_state_on fn)
 {
-    return on_state_changed(
-        [fn_ = std::move(fn)](gpio::state state)
-        { if(state == on) fn_(); }
-    );
+    return state_changed_.add([fn = std::move(fn)](gpio::state){ fn(); }, 1 << on);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 cid pin_base::on_state_off(fn_state_off fn)
 {
-    return on_state_changed(
-        [fn_ = std::move(fn)](gpio::state state)
-        { if(state == off) fn_(); }
-    );
+    return state_changed_.add([fn = std::move(fn)](gpio::state){ fn(); }, 1 << off);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cid pin_base::on_edge(fn_edge fn)
+{
+    return edge_.add(std::move(fn));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cid pin_base::on_events(fn_events fn)
+{
+    return events_.add(std::move(fn));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 bool pin_base::remove(cid id)
 {
-    return state_changed_.remove(id);
+    return state_changed_.remove(id) || edge_.remove(id) || events_.remove(id)
+        || counter_.remove(id) || capture_.remove(id);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::debounce(nsec time)
+{
+    debounce_ = sw_debounce_ = std::max(time, 0ns);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::count(nsec window)
+{
+    window_ = std::max(window, 0ns);
+
+    edges_ = 0; missed_ = 0;
+    freq_ = 0; last_ = 0;
+    rises_ = 0;
+
+    ++count_gen_;
+    if(count_timer_) count_timer_->cancel();
+
+    if(window_ > 0ns)
+    {
+        if(!count_timer_) count_timer_ = std::make_unique<asio::steady_timer>(io_);
+
+        tick_ = std::chrono::steady_clock::now();
+        sched_count();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+gpio::counter pin_base::counter() const noexcept
+{
+    gpio::counter counter;
+
+    counter.edges = edges_.load(std::memory_order_relaxed);
+    counter.missed = missed_.load(std::memory_order_relaxed);
+    counter.freq = freq_.load(std::memory_order_relaxed);
+    counter.time = timestamp(nsec(last_.load(std::memory_order_relaxed)));
+
+    return counter;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cid pin_base::on_counter(fn_counter fn)
+{
+    return counter_.add(std::move(fn));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::capture(bool on)
+{
+    capturing_ = on;
+    cap_rise_ = cap_prev_ = timestamp { };
+    cap_high_ = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+gpio::capture pin_base::captured() const noexcept
+{
+    gpio::capture capture;
+    unsigned seq;
+    do
+    {
+        while((seq = cap_seq_.load(std::memory_order_acquire)) & 1);
+
+        capture.width = nsec(cap_width_.load(std::memory_order_relaxed));
+        capture.period = nsec(cap_period_.load(std::memory_order_relaxed));
+        capture.time = timestamp(nsec(cap_time_.load(std::memory_order_relaxed)));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    while(seq != cap_seq_.load(std::memory_order_relaxed));
+
+    return capture;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+cid pin_base::on_capture(fn_capture fn)
+{
+    return capture_.add(std::move(fn));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::missed(std::uint64_t n) noexcept
+{
+    if(window_ > 0ns && n)
+    {
+        missed_.fetch_add(n, std::memory_order_relaxed);
+        edges_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    // don't pair edges across the gap
+    if(capturing_ && n)
+    {
+        cap_rise_ = cap_prev_ = timestamp { };
+        cap_high_ = false;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::dispatch(const event* begin, const event* end)
+{
+    if(sw_debounce_ > 0ns)
+        filter(begin, end);
+    else
+    {
+        settled_ = -1;
+        invoke(begin, end);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::filter(const event* begin, const event* end)
+{
+    if(!timer_) timer_ = std::make_unique<asio::steady_timer>(io_);
+
+    for(auto ev = begin; ev != end; ++ev)
+    {
+        ++timer_gen_;
+        timer_->cancel();
+
+        // bounced back to the settled state
+        if(ev->state == settled_) continue;
+
+        pending_ = *ev;
+        timer_->expires_at(ev->time + sw_debounce_);
+        timer_->async_wait([&, gen = timer_gen_](const asio::error_code& ec)
+        {
+            if(ec || gen != timer_gen_) return;
+
+            settled_ = pending_.state;
+            invoke(&pending_, &pending_ + 1);
+        });
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::invoke(const event* begin, const event* end)
+{
+    if(begin == end) return;
+
+    if(window_ > 0ns) tally(begin, end);
+    if(capturing_) pair(begin, end);
+
+    if(!events_.empty()) events_(events { begin, end });
+    if(!state_changed_.empty() || !edge_.empty())
+        for(auto ev = begin; ev != end; ++ev)
+        {
+            state_changed_.call_if(1 << ev->state, ev->state);
+            edge_(ev->state, ev->time);
+        }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::tally(const event* begin, const event* end)
+{
+    for(auto ev = begin; ev != end; ++ev)
+        if(ev->state == on)
+        {
+            rise_ = ev->time;
+            if(rises_++ == 0) rise0_ = rise_;
+            else if(rise_ - rise0_ >= window_)
+            {
+                // number of whole periods over the time they took
+                freq_.store(
+                    (rises_ - 1) * 1e9 / static_cast<double>((rise_ - rise0_).count()),
+                    std::memory_order_relaxed
+                );
+                rises_ = 1;
+                rise0_ = rise_;
+            }
+        }
+
+    edges_.fetch_add(static_cast<std::uint64_t>(end - begin), std::memory_order_relaxed);
+    last_.store((end - 1)->time.time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::sched_count()
+{
+    tick_ += window_;
+    count_timer_->expires_at(tick_);
+    count_timer_->async_wait([&, gen = count_gen_](const asio::error_code& ec)
+    {
+        if(ec || gen != count_gen_) return;
+
+        // signal has stopped: no rising edges for two windows
+        // (or two periods of a slower signal)
+        auto freq = freq_.load(std::memory_order_relaxed);
+        if(freq > 0)
+        {
+            auto quiet = std::max(2 * window_, nsec(static_cast<nsec::rep>(2e9 / freq)));
+            if(std::chrono::steady_clock::now() - rise_ > quiet)
+            {
+                freq_.store(0, std::memory_order_relaxed);
+                rises_ = 0;
+            }
+        }
+
+        if(!counter_.empty()) counter_(counter());
+
+        // NB: callbacks could have restarted or stopped the counter
+        if(gen == count_gen_) sched_count();
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin_base::pair(const event* begin, const event* end)
+{
+    constexpr timestamp none { };
+
+    for(auto ev = begin; ev != end; ++ev)
+        if(ev->state == on)
+        {
+            cap_prev_ = cap_rise_;
+            cap_rise_ = ev->time;
+            cap_high_ = true;
+        }
+        // falling edge without a rising one is not a pulse
+        else if(cap_high_)
+        {
+            cap_high_ = false;
+
+            gpio::capture capture;
+            capture.width = ev->time - cap_rise_;
+            if(cap_prev_ != none) capture.period = cap_rise_ - cap_prev_;
+            capture.time = ev->time;
+
+            auto seq = cap_seq_.load(std::memory_order_relaxed);
+            cap_seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            cap_width_.store(capture.width.count(), std::memory_order_relaxed);
+            cap_period_.store(capture.period.count(), std::memory_order_relaxed);
+            cap_time_.store(capture.time.time_since_epoch().count(), std::memory_order_relaxed);
+
+            cap_seq_.store(seq + 2, std::memory_order_release);
+
+            if(!capture_.empty()) capture_(capture);
+        }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
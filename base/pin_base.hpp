@@ -12,8 +12,13 @@
 #include <gpio++/pin.hpp>
 #include <gpio++/types.hpp>
 
-#include <set>
+#include <asio/io_service.hpp>
+#include <asio/steady_timer.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <system_error>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace gpio
@@ -24,7 +29,7 @@ class pin_base : public pin
 {
 public:
     ////////////////////
-    pin_base(gpio::chip*, gpio::pos) noexcept;
+    pin_base(asio::io_service&, gpio::chip*, gpio::pos) noexcept;
     virtual ~pin_base() override;
 
     pin_base(const pin_base&) = delete;
@@ -50,9 +55,9 @@ public:
     virtual bool is(gpio::flag flag) const noexcept override { return flags_ & flag; }
 
     virtual bool supports(gpio::mode mode) const noexcept override
-    { return valid_modes_.count(mode); }
+    { return valid_modes_ & (1u << mode); }
     virtual bool supports(gpio::flag flag) const noexcept override
-    { return valid_flags_.count(flag); }
+    { return flag && (valid_flags_ & flag) == flag; }
 
     ////////////////////
     virtual void detach() override { }
@@ -76,16 +81,54 @@ public:
     virtual void duty_cycle(percent) override;
     virtual percent duty_cycle() const noexcept override;
 
+    virtual void set(gpio::state state, std::error_code& ec) noexcept override
+    { ec.clear(); pin_base::set(state); }
+    virtual gpio::state state(std::error_code& ec) noexcept override
+    { ec.clear(); return pin_base::state(); }
+    virtual void period(nsec period, std::error_code& ec) noexcept override
+    { ec.clear(); pin_base::period(period); }
+    virtual void pulse(nsec pulse, std::error_code& ec) noexcept override
+    { ec.clear(); pin_base::pulse(pulse); }
+
+    virtual pwm_stats stats() const override { return { }; }
+
     ////////////////////
     // digital callback
     virtual cid on_state_changed(fn_state_changed) override;
     virtual cid on_state_on(fn_state_on) override;
     virtual cid on_state_off(fn_state_off) override;
 
+    virtual cid on_edge(fn_edge) override;
+
+    virtual cid on_events(fn_events) override;
+
     virtual bool remove(cid) override;
 
+    // software debounce
+    virtual void debounce(nsec) override;
+    virtual nsec debounce() const noexcept override { return debounce_; }
+
+    ////////////////////
+    // edge counter
+    virtual void count(nsec = 1s) override;
+    virtual nsec count() const noexcept override { return window_; }
+
+    virtual gpio::counter counter() const noexcept override;
+
+    virtual cid on_counter(fn_counter) override;
+
+    ////////////////////
+    // input capture
+    virtual void capture(bool = true) override;
+    virtual bool is_capturing() const noexcept override { return capturing_; }
+
+    virtual gpio::capture captured() const noexcept override;
+
+    virtual cid on_capture(fn_capture) override;
+
 protected:
     ////////////////////
+    asio::io_service& io_;
     gpio::chip* chip_ = nullptr;
 
     gpio::pos pos_;
@@ -95,12 +138,92 @@ protected:
     gpio::flag flags_ { };
     bool used_ = false;
 
-    std::set<gpio::mode> valid_modes_;
-    std::set<gpio::flag> valid_flags_;
+    // bit (1 << mode) set for each valid mode, valid flags or'ed together
+    unsigned valid_modes_ = 0;
+    unsigned valid_flags_ = 0;
 
     nsec period_ = 10ms, pulse_ = 0ns;
 
+    // state changed and state on/off callbacks
+    // (filtered by 1 << state) in the order they were added
     call_chain<fn_state_changed> state_changed_;
+    call_chain<fn_edge> edge_;
+    call_chain<fn_events> events_;
+
+    // invoke callbacks for a batch of received events
+    void dispatch(const event* begin, const event* end);
+
+    // report edges that were dropped before they could be read
+    void missed(std::uint64_t) noexcept;
+
+    ////////////////////
+    // error reported by non-throwing functions of detached pins
+    static std::error_code detached_error() noexcept
+    { return std::make_error_code(std::errc::bad_file_descriptor); }
+
+    // throw error returned by a non-throwing function
+    [[noreturn]] void throw_error(const std::string& what, const std::error_code&) const;
+
+    ////////////////////
+    // debounce period & part of it done in software
+    // (backends doing it in hardware set sw_debounce_ to 0)
+    nsec debounce_ = 0ns, sw_debounce_ = 0ns;
+
+private:
+    ////////////////////
+    // software debounce filter:
+    // hold on to the last transition until the period elapses
+    // since its timestamp with no other transitions
+    std::unique_ptr<asio::steady_timer> timer_;
+    unsigned timer_gen_ = 0;
+
+    int settled_ = -1;
+    event pending_ { };
+
+    void filter(const event* begin, const event* end);
+    void invoke(const event* begin, const event* end);
+
+    ////////////////////
+    // edge counter:
+    // count edges as they are dispatched and measure frequency
+    // from the number of rising edges seen within the window
+    nsec window_ = 0ns;
+
+    std::atomic<std::uint64_t> edges_ { 0 }, missed_ { 0 };
+    std::atomic<double> freq_ { 0 };
+    std::atomic<nsec::rep> last_ { 0 };
+
+    // rising edges since the start of the window,
+    // time of the first and last one
+    std::uint64_t rises_ = 0;
+    timestamp rise0_, rise_;
+
+    call_chain<fn_counter> counter_;
+
+    std::unique_ptr<asio::steady_timer> count_timer_;
+    unsigned count_gen_ = 0;
+    timestamp tick_;
+
+    void tally(const event* begin, const event* end);
+    void sched_count();
+
+    ////////////////////
+    // input capture:
+    // last pulse is published with a sequence lock
+    // (odd while being written) for lock-free reads
+    bool capturing_ = false;
+
+    std::atomic<unsigned> cap_seq_ { 0 };
+    std::atomic<nsec::rep> cap_width_ { 0 }, cap_period_ { 0 }, cap_time_ { 0 };
+
+    // last & previous rising edge (0 = none)
+    timestamp cap_rise_, cap_prev_;
+    // waiting for falling edge
+    bool cap_high_ = false;
+
+    call_chain<fn_capture> capture_;
+
+    void pair(const event* begin, const event* end);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
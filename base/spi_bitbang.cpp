@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "timing.hpp"
+#include "type_id.hpp"
+
+#include <gpio++/spi.hpp>
+
+#include <chrono>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+spi_bitbang::spi_bitbang(gpio::chip* chip, gpio::pos sclk, gpio::pos mosi,
+    gpio::pos miso, gpio::pos cs, spi_mode mode
+) :
+    chip_(chip), mode_(mode)
+{
+    if(sclk == npos || mosi == npos) throw std::invalid_argument(
+        type_id(chip_) + ": Cannot create spi - Clock and MOSI pins are required"
+    );
+
+    std::vector<gpio::pos> pos { sclk, mosi };
+    sclk_ = 0b01; mosi_ = 0b10;
+
+    // cs is active low and starts de-asserted
+    if(cs != npos) { pos.push_back(cs); cs_ = 0b100; }
+
+    out_ = chip_->group(std::move(pos), out, clk_idle() | cs_);
+    if(miso != npos) in_ = chip_->group({ miso }, in);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void spi_bitbang::clock(unsigned hz) noexcept
+{
+    hz_ = hz;
+    half_ = hz ? nsec { 500000000 / hz } : 0ns;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void spi_bitbang::transfer(const std::uint8_t* tx, std::uint8_t* rx, std::size_t size)
+{
+    const auto& timing = chip_->timing();
+    auto tp = std::chrono::steady_clock::now();
+
+    auto wait = [&]()
+    {
+        if(half_.count())
+        {
+            tp += half_;
+            wait_until(tp, timing);
+        }
+    };
+
+    const mask idle = clk_idle(), active = idle ^ sclk_;
+    const mask lines = sclk_ | mosi_ | cs_;
+    const bool cpha = mode_ & 1;
+
+    // assert cs (if any) together with the first data bit below
+    mask value = idle;
+
+    for(std::size_t n = 0; n < size; ++n)
+    {
+        std::uint8_t out = tx ? tx[n] : 0, in = 0;
+
+        for(int i = 0; i < 8; ++i)
+        {
+            std::uint8_t bit = lsb_ ? (1 << i) : (0x80 >> i);
+            mask data = (out & bit) ? mosi_ : 0;
+
+            if(!cpha)
+            {
+                // data with clock idle, then sample on the leading edge
+                out_->set(value = idle | data, lines);
+                wait();
+                out_->set(value = active | data, lines);
+                if(in_ && in_->state()) in |= bit;
+                wait();
+            }
+            else
+            {
+                // data on the leading edge, then sample on the trailing edge
+                out_->set(value = active | data, lines);
+                wait();
+                if(in_ && in_->state()) in |= bit;
+                out_->set(value = idle | data, lines);
+                wait();
+            }
+        }
+        if(rx) rx[n] = in;
+    }
+
+    if(!size) return;
+
+    // return clock to idle and release cs (eg, latch 74HC595)
+    value = (value & mosi_) | idle;
+    if(!cpha) out_->set(value, lines);
+    if(cs_)
+    {
+        wait();
+        out_->set(value | cs_, lines);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void spi_bitbang::idle()
+{
+    out_->set(clk_idle() | cs_, sclk_ | cs_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "timing.hpp"
+
+#include <cerrno>
+#include <system_error>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+void apply(std::thread& thread, const gpio::timing& timing, const gpio::timing& prev)
+{
+    auto handle = thread.native_handle();
+
+    // only change settings that are (or were) set, so that threads
+    // with default timing keep inherited policy and affinity (eg, taskset)
+    if(timing.priority || prev.priority)
+    {
+        sched_param param { };
+        param.sched_priority = timing.priority;
+
+        auto ec = pthread_setschedparam(handle, timing.priority ? SCHED_FIFO : SCHED_OTHER, &param);
+        if(ec) throw std::system_error(ec, std::system_category(), "Cannot set thread priority");
+    }
+
+    ////////////////////
+    if(timing.cpu >= 0 || prev.cpu >= 0)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        int ec = 0;
+        if(timing.cpu >= 0)
+            CPU_SET(timing.cpu, &set);
+        // back to affinity of the calling thread
+        else ec = pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+
+        if(!ec) ec = pthread_setaffinity_np(handle, sizeof(set), &set);
+        if(ec) throw std::system_error(ec, std::system_category(), "Cannot set thread affinity");
+    }
+
+    ////////////////////
+    if(timing.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE))
+        throw std::system_error(errno, std::system_category(), "Cannot lock memory");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void wait_until(std::chrono::steady_clock::time_point tp, const gpio::timing& timing)
+{
+    std::this_thread::sleep_until(tp - timing.spin);
+    while(std::chrono::steady_clock::now() < tp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,34 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_BASE_TIMING_HPP
+#define GPIO_BASE_TIMING_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/timing.hpp>
+#include <gpio++/types.hpp>
+
+#include <chrono>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// apply timing options to thread, which had the prev ones applied
+// throws std::system_error
+void apply(std::thread&, const gpio::timing&, const gpio::timing& prev = { });
+
+// sleep until tp (or until timing::spin before tp, then spin)
+void wait_until(std::chrono::steady_clock::time_point tp, const gpio::timing&);
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
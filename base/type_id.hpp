@@ -10,6 +10,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 #include <gpio++/chip.hpp>
+#include <gpio++/group.hpp>
 #include <gpio++/pin.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -32,6 +33,17 @@ inline std::string type_id(const gpio::pin* pin)
     return type_id(pin->chip()) + '#' + std::to_string(pin->pos());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// group id
+inline std::string type_id(const gpio::group* group)
+{
+    std::string id;
+    for(std::size_t n = 0; n < group->size(); ++n)
+        id += (n ? ',' : '#') + std::to_string(group->pos(n));
+
+    return type_id(group->chip()) + id;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 }
 
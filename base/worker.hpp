@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_BASE_WORKER_HPP
+#define GPIO_BASE_WORKER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "timing.hpp"
+
+#include <gpio++/timing.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// dedicated thread for time-critical bit-banged transactions
+//
+// Callers block in run() until the job completes on the worker thread;
+// exceptions thrown by the job are re-thrown in the caller.
+//
+class worker
+{
+public:
+    ////////////////////
+    explicit worker(const gpio::timing& timing) : thread_([this](){ loop(); })
+    {
+        try { apply(thread_, timing); }
+        catch(...)
+        {
+            quit();
+            throw;
+        }
+    }
+    ~worker() { quit(); }
+
+    ////////////////////
+    template<typename Fn>
+    auto run(Fn&& fn)
+    {
+        std::packaged_task<decltype(fn())()> task { std::forward<Fn>(fn) };
+        auto result = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock { mutex_ };
+            jobs_.emplace_back([&task](){ task(); });
+        }
+        cv_.notify_one();
+        return result.get();
+    }
+
+private:
+    ////////////////////
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> jobs_;
+    bool done_ = false;
+
+    std::thread thread_;
+
+    void loop()
+    {
+        std::unique_lock<std::mutex> lock { mutex_ };
+        for(;;)
+        {
+            cv_.wait(lock, [&](){ return done_ || jobs_.size(); });
+            if(jobs_.empty()) break;
+
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+
+            lock.unlock();
+            job();
+            lock.lock();
+        }
+    }
+
+    void quit()
+    {
+        {
+            std::lock_guard<std::mutex> lock { mutex_ };
+            done_ = true;
+        }
+        cv_.notify_one();
+        if(thread_.joinable()) thread_.join();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+// Per-event cost of dispatching state changes to 4 on/off callbacks:
+//
+// - map: callbacks keyed by call id, each state on/off callback wrapped in
+//   a state changed callback, which checks the state (previous call_chain)
+// - chain: call_chain with filters, as used by pin_base
+//
+#include <gpio++/types.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+////////////////////////////////////////////////////////////////////////////////
+using namespace gpio;
+using clock_type = std::chrono::steady_clock;
+
+constexpr int callbacks = 4;
+constexpr int count = 20000000;
+
+volatile int sink = 0;
+
+template<typename Fn>
+double measure(Fn&& fn)
+{
+    auto t0 = clock_type::now();
+    for(int n = 0; n < count; ++n) fn(static_cast<state>(n & 1));
+    auto t1 = clock_type::now();
+
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::map<cid, fn_state_changed> map;
+    for(int n = 0; n < callbacks; ++n)
+    {
+        fn_state_on fn = [](){ ++sink; };
+        map.emplace(get_cid(), [fn](state s){ if(s == on) fn(); });
+    }
+
+    call_chain<fn_state_changed> chain;
+    for(int n = 0; n < callbacks; ++n)
+        chain.add([](state){ ++sink; }, 1 << on);
+
+    auto t_map = measure([&](state s){ for(auto& e : map) e.second(s); });
+    auto t_chain = measure([&](state s){ chain.call_if(1 << s, s); });
+
+    std::printf("map:   %6.2f ns/event\n", t_map);
+    std::printf("chain: %6.2f ns/event\n", t_chain);
+}
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+// Per-call cost of writing an output line through:
+//
+// - pin: gpio::pin::set() (virtual, own line request)
+// - group: gpio::group::set() (virtual, group line request)
+// - static: gpio::generic::static_line::set() (inlined ioctl)
+//
+// Usage: bench-static_bus <chip id> <pin #> [count]
+//
+// NB: the pin is toggled as fast as possible
+//
+#include <gpio++.hpp>
+#include <gpio++/static_bus.hpp>
+
+#include <asio.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+using namespace gpio;
+using clock_type = std::chrono::steady_clock;
+
+template<typename Fn>
+double measure(long count, Fn&& fn)
+{
+    auto t0 = clock_type::now();
+    for(long n = 0; n < count; ++n) fn(static_cast<state>(n & 1));
+    auto t1 = clock_type::now();
+
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+try
+{
+    if(argc < 3)
+    {
+        std::printf("Usage: %s <chip id> <pin #> [count]\n", argv[0]);
+        return 1;
+    }
+
+    asio::io_service io;
+    auto chip = get_chip(io, argv[1]);
+    auto n = static_cast<pos>(std::stoul(argv[2]));
+    long count = argc > 3 ? std::stol(argv[3]) : 1000000;
+
+    double t_pin, t_group, t_static;
+    {
+        auto pin = chip->pin(n);
+        pin->mode(out);
+        t_pin = measure(count, [&](state s){ pin->set(s); });
+        pin->detach();
+    }
+    {
+        auto group = chip->group({ n }, out);
+        t_group = measure(count, [&](state s){ group->set(s); });
+    }
+    {
+        generic::static_line line(chip.get(), n);
+        t_static = measure(count, [&](state s){ line.set(s); });
+    }
+
+    std::printf("pin:    %8.1f ns/call\n", t_pin);
+    std::printf("group:  %8.1f ns/call\n", t_group);
+    std::printf("static: %8.1f ns/call\n", t_static);
+    return 0;
+}
+catch(const std::exception& e)
+{
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+}
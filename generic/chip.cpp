@@ -7,9 +7,15 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "io_cmd.hpp"
 #include "chip.hpp"
+#include "group.hpp"
 #include "pin.hpp"
+#include "pwm_chip.hpp"
+#include "request.hpp"
 #include "type_id.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 
@@ -26,7 +32,7 @@ namespace generic
 
 ////////////////////////////////////////////////////////////////////////////////
 chip::chip(asio::io_service& io, std::string id) :
-    chip_base("chip"), fd_(io)
+    chip_base("chip"), io_(io), fd_(io), pwm_(this)
 {
     if(id.find_first_not_of("0123456789") != std::string::npos
         || id.size() < 1 || id.size() > 3)
@@ -57,25 +63,135 @@ chip::chip(asio::io_service& io, std::string id) :
 
     name_ = cmd.data_.label;
 
-    for(gpio::pos n = 0; n < cmd.data_.lines; ++n)
-        pins_.emplace_back(new generic::pin(io, this, n));
+    pins_.resize(cmd.data_.lines);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 chip::~chip()
 {
+    for(auto& req : requests_) req->clear();
     pins_.clear();
+    requests_.clear();
 
     asio::error_code ec;
     fd_.close(ec);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void chip::timing(const gpio::timing& timing)
+{
+    pwm_.timing(timing);
+    chip_base::timing(timing);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void chip::watch(const std::vector<gpio::pos>& pos, gpio::flag flags)
+{
+    std::vector<generic::pin*> pins;
+    std::uint64_t value = 0;
+    nsec debounce = 0ns;
+
+    for(auto n : pos)
+    {
+        auto pin = static_cast<generic::pin*>(this->pin(n));
+        if(std::find(pins.begin(), pins.end(), pin) != pins.end())
+            throw std::invalid_argument(
+                type_id(this) + ": Cannot watch pins - Duplicate pin # " + std::to_string(n)
+            );
+
+        value = pin->line_flags(in, flags);
+        // one debounce period for all lines
+        debounce = std::max(debounce, pin->debounce_);
+        pins.push_back(pin);
+    }
+
+    // release lines before requesting them together
+    for(auto pin : pins) pin->detach();
+    watch(pins, value | GPIO_V2_LINE_FLAG_INPUT
+        | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING, debounce
+    );
+
+    for(auto pin : pins)
+    {
+        pin->mode_ = in;
+        pin->flags_ = flags;
+        pin->used_ = true;
+        pin->debounce_ = debounce;
+    }
+}
+
+void chip::watch(const std::vector<generic::pin*>& pins, std::uint64_t flags, nsec debounce)
+{
+    // lines can't be added to a request in use without losing edges
+    // of the other lines, so reuse one without pins or make a new one
+    auto it = std::find_if(requests_.begin(), requests_.end(),
+        [](const auto& req){ return req->empty(); }
+    );
+    if(it == requests_.end())
+    {
+        requests_.emplace_back(new generic::request(io_, this, flags, 0, debounce));
+        it = std::prev(requests_.end());
+    }
+    else it->reset(new generic::request(io_, this, flags, 0, debounce));
+
+    (*it)->add(pins);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void chip::sched_info()
+{
+    if(watching_) return;
+    watching_ = true;
+
+    if(info_buf_.empty()) info_buf_.resize(16 * sizeof(gpio_v2_line_info_changed));
+
+    // kernel returns as many whole events as will fit
+    fd_.async_read_some(asio::buffer(info_buf_),
+        [&](const asio::error_code& ec, std::size_t size)
+        {
+            if(ec) return;
+            watching_ = false;
+
+            auto ev = reinterpret_cast<const gpio_v2_line_info_changed*>(info_buf_.data());
+            auto end = ev + size / sizeof(gpio_v2_line_info_changed);
+
+            for(; ev != end; ++ev)
+            {
+                auto n = static_cast<gpio::pos>(ev->info.offset);
+                if(n < pins_.size() && pins_[n])
+                    static_cast<generic::pin*>(pins_[n].get())->update(ev->info);
+            }
+
+            sched_info();
+        }
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+chip::unique_pin chip::make_pin(gpio::pos n)
+{
+    return std::make_unique<generic::pin>(io_, this, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unique_group chip::group(std::vector<gpio::pos> pos, gpio::mode mode, gpio::flag flags, mask value)
+{
+    return std::make_unique<generic::group>(io_, this, std::move(pos), mode, flags, value);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 unique_chip get_chip(asio::io_service& io, std::string param)
 {
+    // hardware pwm chip: "pwmN" or path to pwmchipN directory
+    if(param.compare(0, 3, "pwm") == 0)
+        return std::make_unique<generic::pwm_chip>(io, "/sys/class/pwm/pwmchip" + param.substr(3));
+
+    if(param.size() && param[0] == '/')
+        return std::make_unique<generic::pwm_chip>(io, std::move(param));
+
     return std::make_unique<generic::chip>(io, std::move(param));
 }
 
@@ -10,10 +10,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 #include "chip_base.hpp"
+#include "pwm_engine.hpp"
 
 #include <asio/posix/stream_descriptor.hpp>
 #include <asio/io_service.hpp>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace gpio
@@ -21,6 +25,10 @@ namespace gpio
 namespace generic
 {
 
+////////////////////////////////////////////////////////////////////////////////
+class pin;
+class request;
+
 ////////////////////////////////////////////////////////////////////////////////
 class chip : public chip_base
 {
@@ -29,10 +37,39 @@ public:
     chip(asio::io_service&, std::string id);
     virtual ~chip() override;
 
+    ////////////////////
+    using chip_base::group;
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode, gpio::flag, mask) override;
+
+    ////////////////////
+    using chip_base::timing;
+    virtual void timing(const gpio::timing&) override;
+
+    // request lines of all pins together
+    virtual void watch(const std::vector<gpio::pos>&, gpio::flag) override;
+
 private:
     ////////////////////
+    asio::io_service& io_;
     asio::posix::stream_descriptor fd_;
+
+    // input line requests (pins requested together share one)
+    std::vector<std::unique_ptr<generic::request>> requests_;
+    void watch(const std::vector<generic::pin*>&, std::uint64_t flags, nsec debounce);
+
+    // software pwm
+    pwm_engine pwm_;
+
+    virtual unique_pin make_pin(gpio::pos) override;
+
+    // line info changes of watched pins
+    std::vector<char> info_buf_;
+    bool watching_ = false;
+    void sched_info();
+
+    friend class group;
     friend class pin;
+    friend class request;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "io_cmd.hpp"
+#include "chip.hpp"
+#include "group.hpp"
+#include "type_id.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <linux/gpio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+group::group(asio::io_service& io, generic::chip* chip, std::vector<gpio::pos> pos,
+    gpio::mode mode, gpio::flag flags, mask value
+) :
+    group_base(io, chip, std::move(pos)), fd_(io)
+{
+    if(pos_.size() > GPIO_V2_LINES_MAX) throw std::invalid_argument(
+        type_id(chip_) + ": Invalid group size " + std::to_string(pos_.size())
+    );
+
+    std::uint64_t request = 0;
+    flags_ = flags;
+
+    if(flags & active_low ) { request |= GPIO_V2_LINE_FLAG_ACTIVE_LOW    ; flags &= ~active_low ; }
+    if(flags & pull_up    ) { request |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP  ; flags &= ~pull_up    ; }
+    if(flags & pull_down  ) { request |= GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN; flags &= ~pull_down  ; }
+    if(flags & open_drain ) { request |= GPIO_V2_LINE_FLAG_OPEN_DRAIN    ; flags &= ~open_drain ; }
+    if(flags & open_source) { request |= GPIO_V2_LINE_FLAG_OPEN_SOURCE   ; flags &= ~open_source; }
+
+    if(flags) throw std::invalid_argument(
+        type_id(this) + ": Cannot set group mode - Invalid flag(s): " + std::to_string(flags)
+    );
+
+    switch(mode)
+    {
+    case in:
+        if(flags_ & (open_drain | open_source)) throw std::invalid_argument(
+            type_id(this) + ": Cannot set group mode - Invalid flag(s) for input: "
+            + std::to_string(flags_ & (open_drain | open_source))
+        );
+        this->request(GPIO_V2_LINE_FLAG_INPUT | request, 0);
+        break;
+
+    case out:
+        this->request(GPIO_V2_LINE_FLAG_OUTPUT | request, value);
+        break;
+
+    default:
+        throw std::invalid_argument(
+            type_id(this) + ": Cannot set group mode - Invalid mode: " + std::to_string(mode)
+        );
+    }
+
+    mode_ = mode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+group::~group()
+{
+    stop();
+
+    asio::error_code ec;
+    fd_.close(ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void group::set(mask values, mask lines)
+{
+    io_cmd<gpio_v2_line_values, GPIO_V2_LINE_SET_VALUES_IOCTL> cmd = { };
+    asio::error_code ec;
+
+    cmd.data_.mask = lines & all();
+    cmd.data_.bits = values & cmd.data_.mask;
+
+    fd_.io_control(cmd, ec);
+    if(ec) throw std::runtime_error(
+        type_id(this) + ": Cannot set group state - " + ec.message()
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+mask group::state()
+{
+    io_cmd<gpio_v2_line_values, GPIO_V2_LINE_GET_VALUES_IOCTL> cmd = { };
+    asio::error_code ec;
+
+    cmd.data_.mask = all();
+
+    fd_.io_control(cmd, ec);
+    if(ec) throw std::runtime_error(
+        type_id(this) + ": Cannot get group state - " + ec.message()
+    );
+
+    return cmd.data_.bits & cmd.data_.mask;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void group::request(std::uint64_t flags, mask value)
+{
+    io_cmd<gpio_v2_line_request, GPIO_V2_GET_LINE_IOCTL> cmd = { };
+    asio::error_code ec;
+
+    for(std::size_t n = 0; n < pos_.size(); ++n)
+        cmd.data_.offsets[n] = static_cast<__u32>(pos_[n]);
+    cmd.data_.num_lines = static_cast<__u32>(pos_.size());
+
+    cmd.data_.config.flags = flags;
+    if(flags & GPIO_V2_LINE_FLAG_OUTPUT)
+    {
+        cmd.data_.config.attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        cmd.data_.config.attrs[0].attr.values = value;
+        cmd.data_.config.attrs[0].mask = all();
+        cmd.data_.config.num_attrs = 1;
+    }
+    std::strncpy(cmd.data_.consumer, type_id(chip_).data(),
+        sizeof(cmd.data_.consumer) - 1
+    );
+
+    static_cast<generic::chip*>(chip_)->fd_.io_control(cmd, ec);
+    if(ec) throw std::runtime_error(
+        type_id(this) + ": Cannot set group mode - " + ec.message()
+    );
+
+    fd_.assign(cmd.data_.fd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int native_handle(gpio::group* group) noexcept
+{
+    auto generic = dynamic_cast<generic::group*>(group);
+    return generic ? generic->native_handle() : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GENERIC_GROUP_HPP
+#define GPIO_GENERIC_GROUP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "group_base.hpp"
+
+#include <asio/io_service.hpp>
+#include <asio/posix/stream_descriptor.hpp>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class chip;
+
+////////////////////////////////////////////////////////////////////////////////
+class group : public group_base
+{
+public:
+    ////////////////////
+    group(asio::io_service&, generic::chip*, std::vector<gpio::pos>,
+        gpio::mode, gpio::flag, mask
+    );
+    virtual ~group() override;
+
+    ////////////////////
+    using group_base::set;
+    virtual void set(mask values, mask lines) override;
+    virtual mask state() override;
+
+    // line request fd (see gpio::generic::native_handle)
+    int native_handle() noexcept { return fd_.native_handle(); }
+
+private:
+    ////////////////////
+    asio::posix::stream_descriptor fd_;
+
+    void request(std::uint64_t flags, mask);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/chip.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <future>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+using names = std::vector<std::pair<std::string, gpio::pos>>;
+
+////////////////////
+// read names of all lines of a chip
+names read_names(const std::string& id)
+{
+    std::string path = "/dev/gpiochip" + id;
+
+    auto fd = ::open(path.data(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) throw std::system_error(
+        errno, std::system_category(), "chip" + id + ": Error opening file " + path
+    );
+
+    names lines;
+    try
+    {
+        gpiochip_info info { };
+        if(::ioctl(fd, GPIO_GET_CHIPINFO_IOCTL, &info) < 0) throw std::system_error(
+            errno, std::system_category(), "chip" + id + ": Error getting chip info"
+        );
+
+        for(gpio::pos n = 0; n < info.lines; ++n)
+        {
+            gpio_v2_line_info line { };
+            line.offset = static_cast<__u32>(n);
+
+            if(::ioctl(fd, GPIO_V2_GET_LINEINFO_IOCTL, &line) < 0) throw std::system_error(
+                errno, std::system_category(), "chip" + id + ": Cannot get pin info"
+            );
+            if(line.name[0]) lines.emplace_back(line.name, n);
+        }
+    }
+    catch(...)
+    {
+        ::close(fd);
+        throw;
+    }
+
+    ::close(fd);
+    return lines;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> get_chip_ids()
+{
+    std::vector<std::string> ids;
+
+    if(auto dir = ::opendir("/dev"))
+    {
+        while(auto entry = ::readdir(dir))
+        {
+            std::string name = entry->d_name;
+            if(name.compare(0, 8, "gpiochip") == 0 && name.size() > 8
+                && name.find_first_not_of("0123456789", 8) == std::string::npos)
+            ids.push_back(name.substr(8));
+        }
+        ::closedir(dir);
+    }
+
+    std::sort(ids.begin(), ids.end(), [](const std::string& x, const std::string& y)
+        { return x.size() < y.size() || (x.size() == y.size() && x < y); }
+    );
+    return ids;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+line_index get_line_index()
+{
+    auto ids = get_chip_ids();
+
+    // read all chips in parallel
+    std::vector<std::future<names>> chips;
+    for(const auto& id : ids)
+        chips.push_back(std::async(std::launch::async, read_names, id));
+
+    line_index index;
+    for(std::size_t n = 0; n < ids.size(); ++n)
+        for(auto& line : chips[n].get())
+            index.emplace(std::move(line.first), line_ref { ids[n], line.second });
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -8,15 +8,16 @@
 #include "io_cmd.hpp"
 #include "chip.hpp"
 #include "pin.hpp"
+#include "request.hpp"
 #include "type_id.hpp"
 
+#include <algorithm>
 #include <asio.hpp>
 #include <chrono>
-#include <cstring>
 #include <initializer_list>
+#include <new>
 #include <stdexcept>
 #include <string>
-#include <thread>
 
 #include <linux/gpio.h>
 
@@ -28,39 +29,28 @@ namespace generic
 
 ////////////////////////////////////////////////////////////////////////////////
 pin::pin(asio::io_service& io, generic::chip* chip, gpio::pos n) :
-    pin_base(chip, n), fd_(io), buffer_(sizeof(gpioevent_data))
+    pin_base(io, chip, n)
 {
-    valid_modes_ = { in, out };
-    valid_flags_ = { active_low, open_drain, open_source };
+    valid_modes_ = 1 << in | 1 << out;
+    valid_flags_ = active_low | pull_up | pull_down | open_drain | open_source;
 
-    get_info();
+    watch_info();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-pin::~pin() { detach(); }
+pin::~pin()
+{
+    try { detach(); } catch(...) { }
+
+    io_cmd<__u32, GPIO_GET_LINEINFO_UNWATCH_IOCTL> cmd { static_cast<__u32>(pos_) };
+    asio::error_code ec;
+    static_cast<generic::chip*>(chip_)->fd_.io_control(cmd, ec);
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 void pin::mode(gpio::mode mode, gpio::flag flags, gpio::state state)
 {
-    detach();
-
-    std::uint32_t value = 0;
-    for(auto flag: valid_flags_)
-        if(flag & flags)
-        {
-            switch(flag)
-            {
-            case active_low : value |= GPIOHANDLE_REQUEST_ACTIVE_LOW ; break;
-            case open_drain : value |= GPIOHANDLE_REQUEST_OPEN_DRAIN ; break;
-            case open_source: value |= GPIOHANDLE_REQUEST_OPEN_SOURCE; break;
-            default:;
-            }
-            flags &= ~flag;
-        }
-
-    if(flags) throw std::invalid_argument(
-        type_id(this) + ": Cannot set pin mode - Invalid flag(s): " + std::to_string(flags)
-    );
+    auto value = line_flags(mode, flags);
 
     switch(mode)
     {
@@ -79,7 +69,42 @@ void pin::mode(gpio::mode mode, gpio::flag flags, gpio::state state)
         );
     }
 
-    get_info();
+    // line info changes will also come through the watch
+    mode_ = mode;
+    flags_ = flags;
+    used_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint64_t pin::line_flags(gpio::mode mode, gpio::flag flags) const
+{
+    auto valid = flags;
+
+    std::uint64_t value = 0;
+    for(auto flag: { active_low, pull_up, pull_down, open_drain, open_source })
+        if(flag & flags)
+        {
+            switch(flag)
+            {
+            case active_low : value |= GPIO_V2_LINE_FLAG_ACTIVE_LOW    ; break;
+            case pull_up    : value |= GPIO_V2_LINE_FLAG_BIAS_PULL_UP  ; break;
+            case pull_down  : value |= GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN; break;
+            case open_drain : value |= GPIO_V2_LINE_FLAG_OPEN_DRAIN    ; break;
+            case open_source: value |= GPIO_V2_LINE_FLAG_OPEN_SOURCE   ; break;
+            }
+            flags &= ~flag;
+        }
+
+    if(flags) throw std::invalid_argument(
+        type_id(this) + ": Cannot set pin mode - Invalid flag(s): " + std::to_string(flags)
+    );
+
+    if(mode == in && (valid & (open_drain | open_source))) throw std::invalid_argument(
+        type_id(this) + ": Cannot set pin mode - Invalid flag(s) for input: "
+        + std::to_string(valid & (open_drain | open_source))
+    );
+
+    return value;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,169 +114,175 @@ void pin::detach()
     {
         pwm_stop();
 
-        fd_.close();
-        get_info();
+        req_->remove(this);
+        own_.reset();
+
+        used_ = false;
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void pin::set(gpio::state state)
 {
-    if(is_detached()) throw std::logic_error(
-        type_id(this) + ": Cannot set pin state - Detached instance"
-    );
-
-    pin_base::set(state);
-    sync_state();
+    std::error_code ec;
+    set(state, ec);
+    if(ec) throw_error("Cannot set pin state", ec);
 }
 
-////////////////////////////////////////////////////////////////////////////////
 gpio::state pin::state()
 {
-    if(is_detached()) throw std::logic_error(
-        type_id(this) + ": Cannot get pin state - Detached instance"
-    );
-
-    io_cmd<gpiohandle_data, GPIOHANDLE_GET_LINE_VALUES_IOCTL> cmd = { };
-    asio::error_code ec;
+    std::error_code ec;
+    auto state = this->state(ec);
+    if(ec) throw_error("Cannot get pin state", ec);
+    return state;
+}
 
-    fd_.io_control(cmd, ec);
-    if(ec) throw std::runtime_error(
-        type_id(this) + ": Cannot get pin state - " + ec.message()
-    );
+void pin::period(nsec period)
+{
+    std::error_code ec;
+    this->period(period, ec);
+    if(ec) throw_error("Cannot set pin period", ec);
+}
 
-    return cmd.data_.values[0] ? on : off;
+void pin::pulse(nsec pulse)
+{
+    std::error_code ec;
+    this->pulse(pulse, ec);
+    if(ec) throw_error("Cannot set pin pulse", ec);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::period(nsec period)
+void pin::set(gpio::state state, std::error_code& ec) noexcept
 {
-    if(is_detached()) throw std::logic_error(
-        type_id(this) + ": Cannot set pin period - Detached instance"
-    );
+    if(is_detached()) { ec = detached_error(); return; }
 
-    pin_base::period(period);
-    sync_state();
+    pin_base::set(state);
+    sync_state(ec);
 }
 
-void pin::pulse(nsec pulse)
+gpio::state pin::state(std::error_code& ec) noexcept
 {
-    if(is_detached()) throw std::logic_error(
-        type_id(this) + ": Cannot set pin pulse - Detached instance"
-    );
+    if(is_detached()) { ec = detached_error(); return off; }
 
-    pin_base::pulse(pulse);
-    sync_state();
+    return req_->state(this, ec);
 }
 
-////////////////////////////////////////////////////////////////////////////////
-void pin::get_info()
+void pin::period(nsec period, std::error_code& ec) noexcept
 {
-    io_cmd<gpioline_info, GPIO_GET_LINEINFO_IOCTL> cmd = { };
-    asio::error_code ec;
+    if(is_detached()) { ec = detached_error(); return; }
 
-    cmd.data_.line_offset = static_cast<__u32>(pos_);
+    pin_base::period(period);
+    sync_state(ec);
+}
 
-    static_cast<generic::chip*>(chip_)->fd_.io_control(cmd, ec);
-    if(ec) throw std::runtime_error(
-        type_id(this) + ": Cannot get pin info - " + ec.message()
-    );
+void pin::pulse(nsec pulse, std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return; }
 
-    name_ = cmd.data_.name;
-    mode_ = cmd.data_.flags & GPIOLINE_FLAG_IS_OUT ? out : in;
+    pin_base::pulse(pulse);
+    sync_state(ec);
+}
 
-    flags_ = { };
-    if(cmd.data_.flags & GPIOLINE_FLAG_ACTIVE_LOW ) flags_ |= active_low;
-    if(cmd.data_.flags & GPIOLINE_FLAG_OPEN_DRAIN ) flags_ |= open_drain;
-    if(cmd.data_.flags & GPIOLINE_FLAG_OPEN_SOURCE) flags_ |= open_source;
+////////////////////////////////////////////////////////////////////////////////
+void pin::debounce(nsec time)
+{
+    // done by the kernel
+    debounce_ = std::max(time, 0ns);
 
-    used_ = cmd.data_.flags & GPIOLINE_FLAG_KERNEL;
+    // re-apply to input pin
+    if(!is_detached() && req_->flags() & GPIO_V2_LINE_FLAG_INPUT)
+        mode_in(req_->flags());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::mode_in(uint32_t flags)
+void pin::watch_info()
 {
-    io_cmd<gpioevent_request, GPIO_GET_LINEEVENT_IOCTL> cmd = { };
+    io_cmd<gpio_v2_line_info, GPIO_V2_GET_LINEINFO_WATCH_IOCTL> cmd = { };
     asio::error_code ec;
 
-    cmd.data_.lineoffset  = static_cast<__u32>(pos_);
-    cmd.data_.handleflags = GPIOHANDLE_REQUEST_INPUT | flags;
-    cmd.data_.eventflags  = GPIOEVENT_REQUEST_BOTH_EDGES;
-    std::strcpy(cmd.data_.consumer_label, type_id(this).data());
+    cmd.data_.offset = static_cast<__u32>(pos_);
 
-    static_cast<generic::chip*>(chip_)->fd_.io_control(cmd, ec);
+    auto chip = static_cast<generic::chip*>(chip_);
+    chip->fd_.io_control(cmd, ec);
     if(ec) throw std::runtime_error(
-        type_id(this) + ": Cannot set pin mode - " + ec.message()
+        type_id(this) + ": Cannot get pin info - " + ec.message()
     );
 
-    fd_.assign(cmd.data_.fd);
-    sched_read();
+    name_ = cmd.data_.name;
+    update(cmd.data_);
+
+    chip->sched_info();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::mode_out(uint32_t flags, gpio::state state)
+void pin::update(const gpio_v2_line_info& info)
 {
-    io_cmd<gpiohandle_request, GPIO_GET_LINEHANDLE_IOCTL> cmd = { };
-    asio::error_code ec;
+    mode_ = info.flags & GPIO_V2_LINE_FLAG_OUTPUT ? out : in;
 
-    cmd.data_.lineoffsets[0]    = static_cast<__u32>(pos_);
-    cmd.data_.flags             = GPIOHANDLE_REQUEST_OUTPUT | flags;
-    cmd.data_.default_values[0] = state;
-    std::strcpy(cmd.data_.consumer_label, type_id(this).data());
-    cmd.data_.lines = 1;
-
-    static_cast<generic::chip*>(chip_)->fd_.io_control(cmd, ec);
-    if(ec) throw std::runtime_error(
-        type_id(this) + ": Cannot set pin mode - " + ec.message()
-    );
+    flags_ = { };
+    if(info.flags & GPIO_V2_LINE_FLAG_ACTIVE_LOW    ) flags_ |= active_low;
+    if(info.flags & GPIO_V2_LINE_FLAG_BIAS_PULL_UP  ) flags_ |= pull_up;
+    if(info.flags & GPIO_V2_LINE_FLAG_BIAS_PULL_DOWN) flags_ |= pull_down;
+    if(info.flags & GPIO_V2_LINE_FLAG_OPEN_DRAIN    ) flags_ |= open_drain;
+    if(info.flags & GPIO_V2_LINE_FLAG_OPEN_SOURCE   ) flags_ |= open_source;
 
-    fd_.assign(cmd.data_.fd);
+    used_ = info.flags & GPIO_V2_LINE_FLAG_USED;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::state(gpio::state state)
+void pin::mode_in(std::uint64_t flags)
 {
-    io_cmd<gpiohandle_data, GPIOHANDLE_SET_LINE_VALUES_IOCTL> cmd = { };
-    asio::error_code ec;
+    flags |= GPIO_V2_LINE_FLAG_INPUT
+        | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
 
-    cmd.data_.values[0] = state;
-    fd_.io_control(cmd, ec);
-    if(ec) throw std::runtime_error(
-        type_id(this) + ": Cannot set pin state - " + ec.message()
-    );
+    pwm_stop();
+    if(own_ || (req_ && req_->size() == 1))
+    {
+        // reconfigure own (or unshared input) request in place
+        req_->config(flags, 0, debounce_);
+    }
+    else
+    {
+        detach();
+        static_cast<generic::chip*>(chip_)->watch({ this }, flags, debounce_);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::sched_read()
+void pin::mode_out(std::uint64_t flags, gpio::state state)
 {
-    asio::async_read(fd_, asio::buffer(buffer_),
-        [&](const asio::error_code& ec, std::size_t)
-        {
-            if(ec) return;
+    flags |= GPIO_V2_LINE_FLAG_OUTPUT;
+    mask values = state ? 1 : 0;
 
-            auto ev = reinterpret_cast<gpioevent_data*>(buffer_.data());
-            auto state = ev->id == GPIOEVENT_EVENT_RISING_EDGE ? on : off;
+    pwm_stop();
+    if(own_)
+    {
+        // reconfigure own request in place
+        own_->config(flags, values);
+    }
+    else
+    {
+        detach();
 
-            state_changed_(state);
-            sched_read();
+        auto chip = static_cast<generic::chip*>(chip_);
+        own_.reset(new generic::request(io_, chip, flags));
+        try { own_->add(this, state); }
+        catch(...)
+        {
+            own_.reset();
+            throw;
         }
-    );
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::sync_state()
+void pin::sync_state(std::error_code& ec) noexcept
 {
-    if(pulse_ == period_)
+    if(pulse_ == period_ || pulse_ == 0ns)
     {
         // no need for pwm - set state directly
         pwm_stop();
-        state(on);
-    }
-    else if(pulse_ == 0ns)
-    {
-        // no need for pwm - set state directly
-        pwm_stop();
-        state(off);
+        req_->state(this, pulse_ == period_ ? on : off, ec);
     }
     else
     {
@@ -259,29 +290,26 @@ void pin::sync_state()
         high_ticks_= pulse_.count();
         low_ticks_ = (period_ - pulse_).count();
 
-        if(!pwm_started()) pwm_start();
+        ec.clear();
+        if(!pwm_started())
+        {
+            if(!(req_->flags() & GPIO_V2_LINE_FLAG_OUTPUT))
+            { ec = std::make_error_code(std::errc::operation_not_permitted); return; }
+
+            // engine thread is started on first use
+            try { pwm_start(); }
+            catch(const std::system_error& e) { ec = e.code(); }
+            catch(const std::bad_alloc&) { ec = std::make_error_code(std::errc::not_enough_memory); }
+            catch(...) { ec = std::make_error_code(std::errc::io_error); }
+        }
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 void pin::pwm_start()
 {
-    stop_ = false;
-    pwm_ = std::async(std::launch::async, [&]()
-    {
-        for(auto tp = std::chrono::high_resolution_clock::now();;)
-        {
-            state(on);
-            tp += nsec(high_ticks_);
-            std::this_thread::sleep_until(tp);
-            if(stop_) break;
-
-            state(off);
-            tp += nsec(low_ticks_);
-            std::this_thread::sleep_until(tp);
-            if(stop_) break;
-        }
-    });
+    static_cast<generic::chip*>(chip_)->pwm_.add(this);
+    pwm_ = true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -289,8 +317,8 @@ void pin::pwm_stop()
 {
     if(pwm_started())
     {
-        stop_ = true;
-        pwm_.get();
+        static_cast<generic::chip*>(chip_)->pwm_.remove(this);
+        pwm_ = false;
     }
 }
 
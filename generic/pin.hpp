@@ -10,13 +10,15 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 #include "pin_base.hpp"
+#include "pwm_engine.hpp"
 
 #include <asio/io_service.hpp>
-#include <asio/posix/stream_descriptor.hpp>
 #include <atomic>
 #include <cstdint>
-#include <future>
-#include <vector>
+#include <memory>
+
+////////////////////////////////////////////////////////////////////////////////
+struct gpio_v2_line_info;
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace gpio
@@ -26,6 +28,7 @@ namespace generic
 
 ////////////////////////////////////////////////////////////////////////////////
 class chip;
+class request;
 
 ////////////////////////////////////////////////////////////////////////////////
 class pin : public pin_base
@@ -39,7 +42,7 @@ public:
     virtual void mode(gpio::mode, gpio::flag, gpio::state) override;
 
     virtual void detach() override;
-    virtual bool is_detached() const noexcept override { return !fd_.is_open(); }
+    virtual bool is_detached() const noexcept override { return !req_; }
 
     ////////////////////
     virtual void set(gpio::state = on) override;
@@ -48,29 +51,48 @@ public:
     virtual void period(nsec) override;
     virtual void pulse(nsec) override;
 
-private:
-    ////////////////////
-    asio::posix::stream_descriptor fd_;
+    virtual void set(gpio::state, std::error_code&) noexcept override;
+    virtual gpio::state state(std::error_code&) noexcept override;
+    virtual void period(nsec, std::error_code&) noexcept override;
+    virtual void pulse(nsec, std::error_code&) noexcept override;
 
-    void get_info();
-    void mode_in(std::uint32_t flags);
-    void mode_out(std::uint32_t flags, gpio::state);
-    void state(gpio::state);
+    virtual pwm_stats stats() const override { return pwm_stats_.stats(); }
 
-    std::vector<char> buffer_;
-    void sched_read();
+    ////////////////////
+    virtual void debounce(nsec) override;
+
+private:
+    ////////////////////
+    // current line request (see generic::request)
+    generic::request* req_ = nullptr;
+    // own line request
+    std::unique_ptr<generic::request> own_;
+    friend class request;
+
+    // line sequence # of the last event (see request::sched_read)
+    std::uint32_t seqno_ = 0;
+
+    // get line info and watch for changes (see chip::sched_info)
+    void watch_info();
+    void update(const gpio_v2_line_info&);
+    friend class chip;
+    // validate flags and convert them to line flags
+    std::uint64_t line_flags(gpio::mode, gpio::flag) const;
+    void mode_in(std::uint64_t flags);
+    void mode_out(std::uint64_t flags, gpio::state);
 
     ////////////////////
     using ticks = nsec::rep;
     std::atomic<ticks> high_ticks_, low_ticks_;
-    void sync_state();
+    void sync_state(std::error_code&) noexcept;
 
-    std::future<void> pwm_;
-    std::atomic<bool> stop_ { false };
+    bool pwm_ = false;
+    pwm_counters pwm_stats_;
+    friend class pwm_engine;
 
     void pwm_start();
     void pwm_stop();
-    bool pwm_started() const noexcept { return pwm_.valid(); }
+    bool pwm_started() const noexcept { return pwm_; }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
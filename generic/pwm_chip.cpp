@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "pwm_chip.hpp"
+#include "pwm_pin.hpp"
+#include "type_id.hpp"
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+pwm_chip::pwm_chip(asio::io_service& io, std::string path) :
+    chip_base("pwm"), io_(io), path_(std::move(path))
+{
+    while(path_.size() > 1 && path_.back() == '/') path_.pop_back();
+
+    auto pos = path_.rfind('/');
+    name_ = path_.substr(pos == std::string::npos ? 0 : pos + 1);
+
+    // use chip # as id
+    pos = name_.find_first_of("0123456789");
+    if(pos != std::string::npos) id_ = name_.substr(pos);
+
+    ////////////////////
+    std::ifstream ifs(path_ + "/npwm");
+    std::size_t count;
+
+    if(!(ifs >> count)) throw std::runtime_error(
+        type_id(this) + ": Error reading file " + path_ + "/npwm"
+    );
+
+    pins_.resize(count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+pwm_chip::~pwm_chip() { pins_.clear(); }
+
+////////////////////////////////////////////////////////////////////////////////
+pwm_chip::unique_pin pwm_chip::make_pin(gpio::pos n)
+{
+    return std::make_unique<generic::pwm_pin>(io_, this, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unique_group pwm_chip::group(std::vector<gpio::pos>, gpio::mode, gpio::flag, mask)
+{
+    throw std::logic_error(
+        type_id(this) + ": Cannot request group - Not supported"
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GENERIC_PWM_CHIP_HPP
+#define GPIO_GENERIC_PWM_CHIP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip_base.hpp"
+
+#include <asio/io_service.hpp>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// hardware pwm chip exposed through sysfs (eg, /sys/class/pwm/pwmchip0)
+class pwm_chip : public chip_base
+{
+public:
+    ////////////////////
+    // path to pwmchipN directory
+    pwm_chip(asio::io_service&, std::string path);
+    virtual ~pwm_chip() override;
+
+    ////////////////////
+    using chip_base::group;
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode, gpio::flag, mask) override;
+
+    ////////////////////
+    const std::string& path() const noexcept { return path_; }
+
+private:
+    ////////////////////
+    asio::io_service& io_;
+    std::string path_;
+
+    virtual unique_pin make_pin(gpio::pos) override;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
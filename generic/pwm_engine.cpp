@@ -0,0 +1,215 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip.hpp"
+#include "pin.hpp"
+#include "pwm_engine.hpp"
+#include "request.hpp"
+#include "timing.hpp"
+#include "type_id.hpp"
+
+#include <algorithm>
+#include <system_error>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_counters::record(nsec lateness, std::uint64_t missed) noexcept
+{
+    auto ns = static_cast<std::uint64_t>(std::max(lateness.count(), nsec::rep { 0 }));
+
+    // log2 bucket
+    std::size_t n = ns ? 63 - static_cast<std::size_t>(__builtin_clzll(ns)) : 0;
+    n = std::min(n, lateness_.size() - 1);
+
+    lateness_[n].fetch_add(1, std::memory_order_relaxed);
+    edges_.fetch_add(1, std::memory_order_relaxed);
+    if(missed) missed_.fetch_add(missed, std::memory_order_relaxed);
+
+    // only written by the engine thread
+    if(lateness.count() > max_lateness_.load(std::memory_order_relaxed))
+        max_lateness_.store(lateness.count(), std::memory_order_relaxed);
+}
+
+pwm_stats pwm_counters::stats() const noexcept
+{
+    pwm_stats stats;
+
+    stats.edges = edges_.load(std::memory_order_relaxed);
+    stats.missed = missed_.load(std::memory_order_relaxed);
+    stats.failed = failed_.load(std::memory_order_relaxed);
+
+    for(std::size_t n = 0; n < lateness_.size(); ++n)
+        stats.lateness[n] = lateness_[n].load(std::memory_order_relaxed);
+    stats.max_lateness = nsec(max_lateness_.load(std::memory_order_relaxed));
+
+    return stats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+pwm_engine::pwm_engine(generic::chip* chip) : chip_(chip) { }
+
+////////////////////////////////////////////////////////////////////////////////
+pwm_engine::~pwm_engine()
+{
+    if(thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_engine::add(generic::pin* pin)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        if(!thread_.joinable())
+        {
+            // thread is blocked on the lock until timing is applied
+            thread_ = std::thread(&pwm_engine::run, this);
+            try { apply(thread_, timing_); }
+            catch(const std::system_error& e)
+            {
+                stop_ = true;
+                lock.unlock();
+
+                thread_.join();
+                stop_ = false;
+
+                throw std::system_error(e.code(), type_id(pin) + ": Cannot start pwm");
+            }
+        }
+
+        auto gen = ++gen_;
+        channels_[pin] = channel { gen, off };
+        queue_.push(edge { clock::now(), pin, gen });
+    }
+    cv_.notify_one();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_engine::remove(generic::pin* pin) noexcept
+{
+    // stale edges are dropped by the engine thread
+    std::lock_guard<std::mutex> lock(mutex_);
+    channels_.erase(pin);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_engine::timing(const gpio::timing& timing)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if(thread_.joinable())
+    {
+        try { apply(thread_, timing, timing_); }
+        catch(const std::system_error& e)
+        {
+            throw std::system_error(e.code(), type_id(chip_) + ": Cannot apply timing");
+        }
+    }
+    timing_ = timing;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_engine::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while(!stop_)
+    {
+        if(queue_.empty())
+        {
+            cv_.wait(lock);
+            continue;
+        }
+
+        auto now = clock::now();
+        auto tp = queue_.top().tp;
+
+        if(tp - timing_.spin > now)
+        {
+            // woken up early when new pins are added
+            cv_.wait_until(lock, tp - timing_.spin);
+            continue;
+        }
+        else if(tp > now)
+        {
+            // spin for the rest of the way
+            lock.unlock();
+            while(clock::now() < tp);
+            lock.lock();
+            continue;
+        }
+
+        // collect all edges that are due
+        writes_.clear();
+        due_.clear();
+        while(!queue_.empty() && queue_.top().tp <= now)
+        {
+            auto ev = queue_.top();
+            queue_.pop();
+
+            auto it = channels_.find(ev.pin);
+            if(it == channels_.end() || it->second.gen != ev.gen) continue;
+
+            nsec high(ev.pin->high_ticks_), low(ev.pin->low_ticks_);
+            auto late = now - ev.tp;
+
+            // late by more than one period -- skip whole periods
+            std::uint64_t missed = static_cast<std::uint64_t>(late / (high + low));
+            ev.tp += missed * (high + low);
+
+            auto& ch = it->second;
+            ch.state = ch.state ? off : on;
+
+            queue_.push(edge { ev.tp + (ch.state ? high : low), ev.pin, ev.gen });
+
+            // combine edges of lines in the same request
+            auto req = ev.pin->req_;
+            auto bit = req->bit(ev.pin);
+
+            auto wr = std::find_if(writes_.begin(), writes_.end(),
+                [&](const write& w){ return w.req == req; }
+            );
+            if(wr == writes_.end()) wr = writes_.insert(writes_.end(), write { req, 0, 0, false });
+
+            wr->lines |= bit;
+            if(ch.state) wr->values |= bit; else wr->values &= ~bit;
+
+            due_.push_back(due { ev.pin, late, missed,
+                static_cast<std::size_t>(wr - writes_.begin())
+            });
+        }
+
+        for(auto& wr : writes_)
+        {
+            std::error_code ec;
+            wr.req->values(wr.lines, wr.values, ec);
+            wr.ok = !ec;
+        }
+
+        // edges are only counted as generated once written
+        for(const auto& d : due_)
+            if(writes_[d.write].ok)
+                d.pin->pwm_stats_.record(d.late, d.missed);
+            else d.pin->pwm_stats_.failed();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
@@ -0,0 +1,147 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GENERIC_PWM_ENGINE_HPP
+#define GPIO_GENERIC_PWM_ENGINE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/timing.hpp>
+#include <gpio++/types.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class chip;
+class pin;
+class request;
+
+////////////////////////////////////////////////////////////////////////////////
+// lock-free pwm timing statistics (see gpio::pwm_stats)
+class pwm_counters
+{
+public:
+    ////////////////////
+    void record(nsec lateness, std::uint64_t missed) noexcept;
+    void failed() noexcept { failed_.fetch_add(1, std::memory_order_relaxed); }
+    pwm_stats stats() const noexcept;
+
+private:
+    ////////////////////
+    std::atomic<std::uint64_t> edges_ { 0 }, missed_ { 0 }, failed_ { 0 };
+
+    std::array<std::atomic<std::uint64_t>, std::tuple_size<decltype(pwm_stats::lateness)>::value> lateness_ { };
+    std::atomic<nsec::rep> max_lateness_ { 0 };
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// software pwm engine
+//
+// Drives all software pwm pins of a chip from one thread using a queue of
+// upcoming edges ordered by deadline.
+//
+// Pins are driven through the line request they already hold (lines are
+// never re-requested while pwm is running, so other lines don't glitch).
+// Edges that fall due together are written out with one write per request,
+// which covers several lines when they were requested together.
+//
+class pwm_engine
+{
+public:
+    ////////////////////
+    explicit pwm_engine(generic::chip*);
+    ~pwm_engine();
+
+    pwm_engine(const pwm_engine&) = delete;
+    pwm_engine& operator=(const pwm_engine&) = delete;
+
+    ////////////////////
+    void add(generic::pin*);
+    // after remove returns the engine no longer touches the pin
+    void remove(generic::pin*) noexcept;
+
+    void timing(const gpio::timing&);
+
+private:
+    ////////////////////
+    generic::chip* chip_;
+
+    ////////////////////
+    using clock = std::chrono::steady_clock;
+
+    struct edge
+    {
+        clock::time_point tp;
+        generic::pin* pin;
+        unsigned gen;
+
+        bool operator>(const edge& rhs) const noexcept { return tp > rhs.tp; }
+    };
+    std::priority_queue<edge, std::vector<edge>, std::greater<edge>> queue_;
+
+    struct channel
+    {
+        unsigned gen;
+        gpio::state state;
+    };
+    std::unordered_map<generic::pin*, channel> channels_;
+    unsigned gen_ = 0;
+
+    // pending writes (request, line mask, values)
+    struct write
+    {
+        generic::request* req;
+        mask lines, values;
+        bool ok;
+    };
+    std::vector<write> writes_;
+
+    // due edges (recorded once their write is done)
+    struct due
+    {
+        generic::pin* pin;
+        nsec late;
+        std::uint64_t missed;
+        std::size_t write;
+    };
+    std::vector<due> due_;
+
+    ////////////////////
+    std::mutex mutex_;
+    std::condition_variable cv_;
+
+    std::thread thread_;
+    bool stop_ = false;
+
+    gpio::timing timing_;
+
+    void run();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "pwm_chip.hpp"
+#include "pwm_pin.hpp"
+#include "type_id.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+auto error() { return std::error_code(errno, std::system_category()).message(); }
+
+bool exists(const std::string& path)
+{
+    struct stat st;
+    return ::stat(path.data(), &st) == 0;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+pwm_pin::pwm_pin(asio::io_service& io, generic::pwm_chip* chip, gpio::pos n) :
+    pin_base(io, chip, n), path_(chip->path() + "/pwm" + std::to_string(n))
+{
+    valid_modes_ = 1 << out;
+    valid_flags_ = active_low;
+
+    // channel exported by someone else
+    used_ = exists(path_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+pwm_pin::~pwm_pin()
+{
+    try { detach(); } catch(...) { }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_pin::mode(gpio::mode mode, gpio::flag flags, gpio::state state)
+{
+    if(mode != out) throw std::invalid_argument(
+        type_id(this) + ": Cannot set pin mode - Invalid mode: " + std::to_string(mode)
+    );
+    if(flags & ~active_low) throw std::invalid_argument(
+        type_id(this) + ": Cannot set pin mode - Invalid flag(s): " + std::to_string(flags)
+    );
+
+    detach();
+
+    ////////////////////
+    if(!exists(path_))
+    {
+        write(static_cast<generic::pwm_chip*>(chip_)->path() + "/export", std::to_string(pos_));
+        exported_ = true;
+    }
+
+    auto open = [&](const std::string& name)
+    {
+        auto path = path_ + '/' + name;
+        auto fd = ::open(path.data(), O_WRONLY | O_CLOEXEC);
+        if(fd < 0) throw std::runtime_error(
+            type_id(this) + ": Error opening file " + path + " - " + error()
+        );
+        return fd;
+    };
+
+    try
+    {
+        enable_ = open("enable");
+        write(enable_, 0);
+
+        // polarity can only be changed while disabled
+        write(path_ + "/polarity", flags & active_low ? "inversed" : "normal");
+
+        period_fd_ = open("period");
+        duty_fd_ = open("duty_cycle");
+
+        pin_base::mode(mode, flags, state);
+
+        // duty cycle must never exceed period
+        pin_base::set(state);
+        write(duty_fd_, 0);
+        write(period_fd_, period_.count());
+        write(duty_fd_, pulse_.count());
+
+        write(enable_, 1);
+    }
+    catch(...)
+    {
+        // close & unexport what was opened so far,
+        // but report the original error
+        try { detach(); } catch(...) { }
+        throw;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_pin::detach()
+{
+    if(enable_ >= 0)
+    {
+        ::write(enable_, "0", 1);
+        ::close(enable_);
+        enable_ = -1;
+    }
+    if(period_fd_ >= 0) { ::close(period_fd_); period_fd_ = -1; }
+    if(duty_fd_ >= 0) { ::close(duty_fd_); duty_fd_ = -1; }
+
+    if(exported_)
+    {
+        exported_ = false;
+        write(static_cast<generic::pwm_chip*>(chip_)->path() + "/unexport", std::to_string(pos_));
+    }
+
+    mode_ = detached;
+    flags_ = { };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_pin::set(gpio::state state)
+{
+    std::error_code ec;
+    set(state, ec);
+    if(ec) throw_error("Cannot set pin state", ec);
+}
+
+void pwm_pin::period(nsec period)
+{
+    std::error_code ec;
+    this->period(period, ec);
+    if(ec) throw_error("Cannot set pin period", ec);
+}
+
+void pwm_pin::pulse(nsec pulse)
+{
+    std::error_code ec;
+    this->pulse(pulse, ec);
+    if(ec) throw_error("Cannot set pin pulse", ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_pin::set(gpio::state state, std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return; }
+
+    auto pulse0 = pulse_;
+    pin_base::set(state);
+
+    write(duty_fd_, pulse_.count(), ec);
+    if(ec) pulse_ = pulse0;
+}
+
+void pwm_pin::period(nsec period, std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return; }
+
+    auto period0 = period_, pulse0 = pulse_;
+    auto shorter = period < period_;
+    pin_base::period(period);
+
+    // duty cycle must never exceed period;
+    // if the second write fails, undo the first one
+    std::error_code undo;
+    if(shorter)
+    {
+        write(duty_fd_, pulse_.count(), ec);
+        if(!ec)
+        {
+            write(period_fd_, period_.count(), ec);
+            if(ec) write(duty_fd_, pulse0.count(), undo);
+        }
+    }
+    else
+    {
+        write(period_fd_, period_.count(), ec);
+        if(!ec)
+        {
+            write(duty_fd_, pulse_.count(), ec);
+            if(ec) write(period_fd_, period0.count(), undo);
+        }
+    }
+
+    if(ec) { period_ = period0; pulse_ = pulse0; }
+}
+
+void pwm_pin::pulse(nsec pulse, std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return; }
+
+    auto pulse0 = pulse_;
+    pin_base::pulse(pulse);
+
+    write(duty_fd_, pulse_.count(), ec);
+    if(ec) pulse_ = pulse0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pwm_pin::write(const std::string& name, const std::string& value)
+{
+    auto fd = ::open(name.data(), O_WRONLY | O_CLOEXEC);
+    if(fd < 0) throw std::runtime_error(
+        type_id(this) + ": Error opening file " + name + " - " + error()
+    );
+
+    auto size = ::write(fd, value.data(), value.size());
+    ::close(fd);
+
+    if(size < 0) throw std::runtime_error(
+        type_id(this) + ": Error writing to file " + name + " - " + error()
+    );
+}
+
+void pwm_pin::write(int fd, nsec::rep value)
+{
+    std::error_code ec;
+    write(fd, value, ec);
+    if(ec) throw std::runtime_error(
+        type_id(this) + ": Error writing value " + std::to_string(value) + " - " + ec.message()
+    );
+}
+
+void pwm_pin::write(int fd, nsec::rep value, std::error_code& ec) noexcept
+{
+    char s[32];
+    auto size = std::snprintf(s, sizeof(s), "%lld\n", static_cast<long long>(value));
+
+    if(::pwrite(fd, s, static_cast<std::size_t>(size), 0) < 0)
+        ec = std::error_code(errno, std::system_category());
+    else ec.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
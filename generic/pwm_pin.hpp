@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GENERIC_PWM_PIN_HPP
+#define GPIO_GENERIC_PWM_PIN_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "pin_base.hpp"
+
+#include <asio/io_service.hpp>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class pwm_chip;
+
+////////////////////////////////////////////////////////////////////////////////
+// hardware pwm channel (eg, /sys/class/pwm/pwmchip0/pwm0)
+//
+// Attribute files are opened once when the pin is attached,
+// so that subsequent updates cost a single write.
+//
+class pwm_pin : public pin_base
+{
+public:
+    ////////////////////
+    pwm_pin(asio::io_service&, generic::pwm_chip*, gpio::pos);
+    virtual ~pwm_pin() override;
+
+    ////////////////////
+    virtual void mode(gpio::mode, gpio::flag, gpio::state) override;
+
+    virtual void detach() override;
+    virtual bool is_detached() const noexcept override { return enable_ < 0; }
+
+    ////////////////////
+    virtual void set(gpio::state = on) override;
+
+    virtual void period(nsec) override;
+    virtual void pulse(nsec) override;
+
+    virtual void set(gpio::state, std::error_code&) noexcept override;
+    virtual void period(nsec, std::error_code&) noexcept override;
+    virtual void pulse(nsec, std::error_code&) noexcept override;
+
+private:
+    ////////////////////
+    std::string path_;
+    bool exported_ = false;
+
+    int period_fd_ = -1, duty_fd_ = -1, enable_ = -1;
+
+    void write(const std::string& name, const std::string& value);
+    void write(int fd, nsec::rep value);
+    void write(int fd, nsec::rep value, std::error_code&) noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,356 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "io_cmd.hpp"
+#include "chip.hpp"
+#include "pin.hpp"
+#include "request.hpp"
+#include "type_id.hpp"
+
+#include <algorithm>
+#include <asio.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <linux/gpio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// max number of events drained with one read
+constexpr std::size_t events_max = 256;
+
+// kernel event buffer size (max allowed) so that
+// high-rate inputs don't overflow between reads
+constexpr __u32 event_buffer_size = GPIO_V2_LINES_MAX * 16;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+request::request(asio::io_service& io, generic::chip* chip, std::uint64_t flags,
+    mask values, nsec debounce
+) :
+    chip_(chip), flags_(flags), values_(values), debounce_(debounce), fd_(io),
+    buffer_(events_max * sizeof(gpio_v2_line_event))
+{
+    queue_.reserve(events_max);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+request::~request()
+{
+    *alive_ = false;
+    clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// fill in line config
+void set_config(gpio_v2_line_config& config,
+    std::uint64_t flags, mask values, nsec debounce, std::size_t lines
+)
+{
+    auto all = lines < 64 ? (mask { 1 } << lines) - 1 : ~mask { 0 };
+
+    config.flags = flags;
+    if(flags & GPIO_V2_LINE_FLAG_OUTPUT)
+    {
+        auto& attr = config.attrs[config.num_attrs++];
+        attr.attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+        attr.attr.values = values;
+        attr.mask = all;
+    }
+    if(flags & GPIO_V2_LINE_FLAG_INPUT && debounce > 0ns)
+    {
+        // round up to usec
+        auto& attr = config.attrs[config.num_attrs++];
+        attr.attr.id = GPIO_V2_LINE_ATTR_ID_DEBOUNCE;
+        attr.attr.debounce_period_us = static_cast<__u32>((debounce.count() + 999) / 1000);
+        attr.mask = all;
+    }
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::config(std::uint64_t flags, mask values, nsec debounce)
+{
+    io_cmd<gpio_v2_line_config, GPIO_V2_LINE_SET_CONFIG_IOCTL> cmd = { };
+    asio::error_code ec;
+
+    set_config(cmd.data_, flags, values, debounce, pins_.size());
+
+    fd_.io_control(cmd, ec);
+    if(ec) throw std::runtime_error(
+        type_id(chip_) + ": Cannot set line config - " + ec.message()
+    );
+
+    flags_ = flags;
+    values_ = values;
+    debounce_ = debounce;
+
+    if(edges() && !reading_) sched_read();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::add(const std::vector<generic::pin*>& pins, mask values)
+{
+    if(!empty()) throw std::logic_error(
+        type_id(chip_) + ": Cannot add lines - Request in use"
+    );
+
+    pins_ = pins;
+    values_ = values;
+
+    try { request_lines(); }
+    catch(...)
+    {
+        pins_.clear();
+        throw;
+    }
+
+    for(auto pin : pins_) pin->req_ = this;
+    live_ = pins_.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::remove(generic::pin* pin) noexcept
+{
+    // NB: line stays requested (and its events are dropped)
+    // until all pins have left
+    pin->req_ = nullptr;
+    pins_[index(pin)] = nullptr;
+
+    if(!--live_) clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::clear() noexcept
+{
+    for(auto pin : pins_) if(pin) pin->req_ = nullptr;
+    pins_.clear();
+    live_ = 0;
+
+    asio::error_code ec;
+    fd_.close(ec);
+    ++gen_;
+
+    reading_ = false;
+    queue_.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::state(const generic::pin* pin, gpio::state state)
+{
+    std::error_code ec;
+    this->state(pin, state, ec);
+    if(ec) throw std::runtime_error(
+        type_id(pin) + ": Cannot set pin state - " + ec.message()
+    );
+}
+
+void request::state(const generic::pin* pin, gpio::state state, std::error_code& ec) noexcept
+{
+    io_cmd<gpio_v2_line_values, GPIO_V2_LINE_SET_VALUES_IOCTL> cmd = { };
+
+    cmd.data_.mask = bit(pin);
+    if(state) cmd.data_.bits = cmd.data_.mask;
+
+    asio::error_code e;
+    fd_.io_control(cmd, e);
+    ec = e;
+
+    if(!ec) values_ = (values_ & ~cmd.data_.mask) | cmd.data_.bits;
+}
+
+void request::values(mask lines, mask values)
+{
+    std::error_code ec;
+    this->values(lines, values, ec);
+    if(ec) throw std::runtime_error(
+        type_id(chip_) + ": Cannot set line values - " + ec.message()
+    );
+}
+
+void request::values(mask lines, mask values, std::error_code& ec) noexcept
+{
+    io_cmd<gpio_v2_line_values, GPIO_V2_LINE_SET_VALUES_IOCTL> cmd = { };
+
+    cmd.data_.mask = lines;
+    cmd.data_.bits = values & lines;
+
+    asio::error_code e;
+    fd_.io_control(cmd, e);
+    ec = e;
+
+    if(!ec) values_ = (values_ & ~lines) | cmd.data_.bits;
+}
+
+gpio::state request::state(const generic::pin* pin)
+{
+    std::error_code ec;
+    auto state = this->state(pin, ec);
+    if(ec) throw std::runtime_error(
+        type_id(pin) + ": Cannot get pin state - " + ec.message()
+    );
+    return state;
+}
+
+gpio::state request::state(const generic::pin* pin, std::error_code& ec) noexcept
+{
+    io_cmd<gpio_v2_line_values, GPIO_V2_LINE_GET_VALUES_IOCTL> cmd = { };
+
+    cmd.data_.mask = bit(pin);
+
+    asio::error_code e;
+    fd_.io_control(cmd, e);
+    ec = e;
+
+    return cmd.data_.bits & cmd.data_.mask ? on : off;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::request_lines()
+{
+    io_cmd<gpio_v2_line_request, GPIO_V2_GET_LINE_IOCTL> cmd = { };
+    asio::error_code ec;
+
+    for(std::size_t n = 0; n < pins_.size(); ++n)
+        cmd.data_.offsets[n] = static_cast<__u32>(pins_[n]->pos());
+    cmd.data_.num_lines = static_cast<__u32>(pins_.size());
+
+    set_config(cmd.data_.config, flags_, values_, debounce_, pins_.size());
+    if(edges()) cmd.data_.event_buffer_size = event_buffer_size;
+
+    std::strncpy(cmd.data_.consumer, type_id(chip_).data(),
+        sizeof(cmd.data_.consumer) - 1
+    );
+
+    // NB: keep error code for the non-throwing pin functions
+    chip_->fd_.io_control(cmd, ec);
+    if(ec) throw std::system_error(std::error_code(ec),
+        type_id(chip_) + ": Cannot request lines"
+    );
+
+    fd_.assign(cmd.data_.fd);
+    for(auto pin : pins_) pin->seqno_ = 0;
+
+    if(edges()) sched_read();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::size_t request::index(const generic::pin* pin) const noexcept
+{
+    return static_cast<std::size_t>(
+        std::find(pins_.begin(), pins_.end(), pin) - pins_.begin()
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool request::edges() const noexcept
+{
+    return flags_ & (GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::sched_read()
+{
+    reading_ = true;
+
+    // kernel returns as many whole events as will fit
+    fd_.async_read_some(asio::buffer(buffer_),
+        [this, alive = alive_, gen = gen_](const asio::error_code& ec, std::size_t size)
+        {
+            // NB: request may be gone (eg, fd closed by the destructor)
+            if(ec || !*alive || gen != gen_) return;
+
+            reading_ = false;
+
+            auto ev = reinterpret_cast<const gpio_v2_line_event*>(buffer_.data());
+            take(ev, ev + size / sizeof(gpio_v2_line_event));
+            flush();
+
+            // NB: callbacks could have destroyed the request,
+            // reconfigured the lines or released them
+            if(*alive && !empty() && edges() && !reading_) sched_read();
+        }
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::take(const gpio_v2_line_event* begin, const gpio_v2_line_event* end)
+{
+    for(auto e = begin; e != end; ++e)
+    {
+        auto pin = static_cast<generic::pin*>(chip_->pins_[e->offset].get());
+
+        // pin has left the request (line is masked out)
+        if(pin->req_ != this) continue;
+
+        // gaps in line sequence # are events
+        // dropped by the kernel (buffer overflow)
+        auto missed = static_cast<__u32>(e->line_seqno - pin->seqno_ - 1);
+        pin->seqno_ = e->line_seqno;
+
+        // v2 events are stamped with CLOCK_MONOTONIC (same as steady_clock)
+        queue_.push_back(item { e->offset, missed, event {
+            e->id == GPIO_V2_LINE_EVENT_RISING_EDGE ? on : off,
+            timestamp(nsec(static_cast<nsec::rep>(e->timestamp_ns)))
+        }});
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void request::flush()
+{
+    auto alive = alive_;
+    auto batch = batch_;
+
+    // callbacks releasing the lines will clear the queue
+    batch->items.clear();
+    batch->items.swap(queue_);
+
+    auto& items = batch->items;
+    auto& events = batch->events;
+
+    // dispatch consecutive events of the same pin together
+    for(std::size_t first = 0, last; first < items.size(); first = last)
+    {
+        std::uint64_t missed = 0;
+        events.clear();
+
+        for(last = first; last < items.size() && items[last].offset == items[first].offset; ++last)
+        {
+            missed += items[last].missed;
+            events.push_back(items[last].ev);
+        }
+
+        // skip pins that have left the request
+        auto pin = static_cast<generic::pin*>(chip_->pins_[items[first].offset].get());
+        if(pin->req_ != this) continue;
+
+        pin->missed(missed);
+        pin->dispatch(events.data(), events.data() + events.size());
+
+        // callbacks have destroyed the request
+        if(!*alive) return;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
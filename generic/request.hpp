@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GENERIC_REQUEST_HPP
+#define GPIO_GENERIC_REQUEST_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/types.hpp>
+
+#include <asio/io_service.hpp>
+#include <asio/posix/stream_descriptor.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+struct gpio_v2_line_event;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class chip;
+class pin;
+
+////////////////////////////////////////////////////////////////////////////////
+// GPIO v2 line request
+//
+// Input pins requested together share one request owned by the chip. Edge
+// events of all pins in the request are read from one fd and are dispatched
+// to each pin in the order they were received.
+//
+// Lines cannot be added to an existing request without releasing and
+// re-requesting all of them, which would lose edges of the watched lines.
+// So lines are only added to a request that has no pins, and pins that are
+// set up later get a new request. Pins that leave the request are masked out
+// (their events are dropped), and the lines are released once all pins have
+// left.
+//
+// Output pins own a single-line request, which is reconfigured in place when
+// the pin changes mode.
+//
+class request
+{
+public:
+    ////////////////////
+    request(asio::io_service&, generic::chip*, std::uint64_t flags,
+        mask values = 0, nsec debounce = 0ns
+    );
+    ~request();
+
+    request(const request&) = delete;
+    request& operator=(const request&) = delete;
+
+    ////////////////////
+    auto flags() const noexcept { return flags_; }
+    auto debounce() const noexcept { return debounce_; }
+
+    // change config of all lines in place
+    void config(std::uint64_t flags, mask values = 0, nsec debounce = 0ns);
+
+    ////////////////////
+    // number of pins (lines are released when there are none)
+    std::size_t size() const noexcept { return live_; }
+    bool empty() const noexcept { return !live_; }
+
+    // request lines of the pins with initial output values
+    // (bit n <-> n-th pin); request must be empty
+    void add(const std::vector<generic::pin*>&, mask values = 0);
+    void add(generic::pin* pin, gpio::state state = off) { add({ pin }, state ? 1 : 0); }
+
+    void remove(generic::pin*) noexcept;
+
+    // remove all pins and release the lines
+    void clear() noexcept;
+
+    ////////////////////
+    void state(const generic::pin*, gpio::state);
+    gpio::state state(const generic::pin*);
+
+    void state(const generic::pin*, gpio::state, std::error_code&) noexcept;
+    gpio::state state(const generic::pin*, std::error_code&) noexcept;
+
+    // bit of the pin within the request
+    mask bit(const generic::pin* pin) const noexcept { return mask { 1 } << index(pin); }
+    // set values of several lines at once
+    void values(mask lines, mask values);
+    void values(mask lines, mask values, std::error_code&) noexcept;
+
+private:
+    ////////////////////
+    generic::chip* chip_;
+    std::uint64_t flags_;
+    mask values_;
+    nsec debounce_;
+
+    asio::posix::stream_descriptor fd_;
+
+    // pins of requested lines (nullptr once the pin has left)
+    std::vector<generic::pin*> pins_;
+    std::size_t live_ = 0;
+
+    // incremented every time lines are released
+    unsigned gen_ = 0;
+
+    // cleared when the request is destroyed;
+    // pending reads (which complete after the fd is closed)
+    // and callbacks that free the request check it
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+
+    void request_lines();
+    std::size_t index(const generic::pin*) const noexcept;
+
+    std::vector<char> buffer_;
+
+    bool reading_ = false;
+    bool edges() const noexcept;
+    void sched_read();
+
+    // events read, but not dispatched yet
+    struct item
+    {
+        std::uint32_t offset;
+        // events missed by the kernel before this one
+        std::uint32_t missed;
+        event ev;
+    };
+    std::vector<item> queue_;
+
+    // batch being dispatched
+    // (shared with flush in case callbacks destroy the request)
+    struct batch
+    {
+        std::vector<item> items;
+        std::vector<event> events;
+    };
+    std::shared_ptr<batch> batch_ = std::make_shared<batch>();
+
+    void take(const gpio_v2_line_event* begin, const gpio_v2_line_event* end);
+    void flush();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
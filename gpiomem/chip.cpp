@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip.hpp"
+#include "group.hpp"
+#include "pin.hpp"
+#include "type_id.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace gpiomem
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+auto error() { return std::error_code(errno, std::system_category()).message(); }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+chip::chip(asio::io_service& io, std::string path, gpio::regmap map) :
+    chip_base("gpiomem"), io_(io), map_(std::move(map))
+{
+    name_ = std::move(path);
+
+    if(map_.fsel_bits < 1 || map_.fsel_bits > 32) throw std::invalid_argument(
+        type_id(this) + ": Invalid register map"
+    );
+
+    auto fd = ::open(name_.data(), O_RDWR | O_SYNC | O_CLOEXEC);
+    if(fd < 0) throw std::runtime_error(
+        type_id(this) + ": Error opening file " + name_ + " - " + error()
+    );
+
+    // stand-in file must be large enough to hold all registers
+    struct stat st;
+    if(::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)
+        && static_cast<std::size_t>(st.st_size) < map_.size)
+    {
+        ::close(fd);
+        throw std::runtime_error(
+            type_id(this) + ": File " + name_ + " is too small"
+        );
+    }
+
+    size_ = map_.size;
+    auto base = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto ec = error();
+    ::close(fd);
+
+    if(base == MAP_FAILED) throw std::runtime_error(
+        type_id(this) + ": Error mapping file " + name_ + " - " + ec
+    );
+    base_ = static_cast<volatile std::uint32_t*>(base);
+
+    pins_.resize(map_.pins);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+chip::~chip()
+{
+    pins_.clear();
+    ::munmap(const_cast<std::uint32_t*>(base_), size_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void chip::fsel(gpio::pos n, gpio::mode mode)
+{
+    auto per_reg = 32 / map_.fsel_bits;
+    auto reg = base_ + map_.fsel + n / per_reg;
+    auto shift = map_.fsel_bits * (n % per_reg);
+
+    std::uint32_t bits = map_.fsel_bits < 32 ? (std::uint32_t { 1 } << map_.fsel_bits) - 1 : ~std::uint32_t { 0 };
+    std::uint32_t value = mode == out ? map_.fsel_out : map_.fsel_in;
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+    *reg = (*reg & ~(bits << shift)) | ((value & bits) << shift);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void chip::pull(gpio::pos n, gpio::flag flag)
+{
+    if(!map_.pull) return;
+
+    std::lock_guard<std::mutex> lock { mutex_ };
+    map_.pull(base_, n, flag);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+chip::unique_pin chip::make_pin(gpio::pos n)
+{
+    return std::make_unique<gpiomem::pin>(io_, this, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unique_group chip::group(std::vector<gpio::pos> pos, gpio::mode mode, gpio::flag flags, mask value)
+{
+    return std::make_unique<gpiomem::group>(io_, this, std::move(pos), mode, flags, value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unique_chip get_chip(asio::io_service& io, std::string path, gpio::regmap map)
+{
+    return std::make_unique<gpiomem::chip>(io, std::move(path), std::move(map));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unique_chip get_chip(asio::io_service& io, std::string param)
+{
+    if(param.empty()) param = "/dev/gpiomem";
+
+    // detect register map
+    std::ifstream ifs("/proc/device-tree/compatible");
+    std::string compatible { std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+
+    return get_chip(io, std::move(param),
+        compatible.find("bcm2711") != std::string::npos ? bcm2711() : bcm2835()
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> get_chip_ids() { return { "/dev/gpiomem" }; }
+
+// registers have no line names
+line_index get_line_index() { return { }; }
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GPIOMEM_CHIP_HPP
+#define GPIO_GPIOMEM_CHIP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip_base.hpp"
+
+#include <gpio++/regmap.hpp>
+
+#include <asio/io_service.hpp>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace gpiomem
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// gpio registers memory-mapped from /dev/gpiomem (or similar device)
+class chip : public chip_base
+{
+public:
+    ////////////////////
+    chip(asio::io_service&, std::string path, gpio::regmap);
+    virtual ~chip() override;
+
+    ////////////////////
+    using chip_base::group;
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode, gpio::flag, mask) override;
+
+    ////////////////////
+    const gpio::regmap& map() const noexcept { return map_; }
+
+    // set function of pin n (in/out)
+    void fsel(gpio::pos n, gpio::mode);
+    // configure pull-up/down resistor of pin n
+    void pull(gpio::pos n, gpio::flag);
+
+    // set/clear pins in bank # (32 pins per bank)
+    void set(std::size_t bank, std::uint32_t bits) noexcept { base_[map_.set + bank] = bits; }
+    void clr(std::size_t bank, std::uint32_t bits) noexcept { base_[map_.clr + bank] = bits; }
+    // read pin levels in bank #
+    std::uint32_t lev(std::size_t bank) const noexcept { return base_[map_.lev + bank]; }
+
+private:
+    ////////////////////
+    asio::io_service& io_;
+
+    gpio::regmap map_;
+    volatile std::uint32_t* base_ = nullptr;
+    std::size_t size_ = 0;
+
+    // guards read-modify-write of shared registers
+    std::mutex mutex_;
+
+    virtual unique_pin make_pin(gpio::pos) override;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
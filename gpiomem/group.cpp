@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip.hpp"
+#include "group.hpp"
+#include "type_id.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace gpiomem
+{
+
+////////////////////////////////////////////////////////////////////////////////
+group::group(asio::io_service& io, gpiomem::chip* chip, std::vector<gpio::pos> pos,
+    gpio::mode mode, gpio::flag flags, mask value
+) :
+    group_base(io, chip, std::move(pos)), mem_(chip)
+{
+    gpio::flag valid = active_low;
+    if(chip->map().pull) valid |= pull_up | pull_down;
+
+    if((flags & ~valid) || ((flags & pull_up) && (flags & pull_down)))
+        throw std::invalid_argument(
+            type_id(this) + ": Cannot set group mode - Invalid flag(s): " + std::to_string(flags)
+        );
+
+    if(mode != in && mode != out) throw std::invalid_argument(
+        type_id(this) + ": Cannot set group mode - Invalid mode: " + std::to_string(mode)
+    );
+
+    bank_min_ = *std::min_element(pos_.begin(), pos_.end()) / 32;
+    bank_max_ = *std::max_element(pos_.begin(), pos_.end()) / 32;
+
+    flags_ = flags;
+    if(mode == out) set(value);
+
+    for(auto n : pos_)
+    {
+        mem_->pull(n, flags & (pull_up | pull_down));
+        mem_->fsel(n, mode);
+    }
+
+    mode_ = mode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+group::~group() { stop(); }
+
+////////////////////////////////////////////////////////////////////////////////
+void group::set(mask values, mask lines)
+{
+    if(is(active_low)) values = ~values;
+
+    // bits are collected on the stack, as set() and state()
+    // may be called from the player thread and the user thread
+    for(std::size_t bank = bank_min_; bank <= bank_max_; ++bank)
+    {
+        std::uint32_t set = 0, clr = 0;
+        for(std::size_t n = 0; n < pos_.size(); ++n)
+            if(pos_[n] / 32 == bank && (lines & (mask { 1 } << n)))
+            {
+                auto bit = std::uint32_t { 1 } << (pos_[n] % 32);
+                if(values & (mask { 1 } << n)) set |= bit; else clr |= bit;
+            }
+
+        if(clr) mem_->clr(bank, clr);
+        if(set) mem_->set(bank, set);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+mask group::state()
+{
+    mask value = 0;
+    for(std::size_t bank = bank_min_; bank <= bank_max_; ++bank)
+    {
+        // sample each bank once
+        auto lev = mem_->lev(bank);
+        for(std::size_t n = 0; n < pos_.size(); ++n)
+            if(pos_[n] / 32 == bank && (lev & (std::uint32_t { 1 } << (pos_[n] % 32))))
+                value |= mask { 1 } << n;
+    }
+
+    return is(active_low) ? ~value & all() : value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
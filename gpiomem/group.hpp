@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GPIOMEM_GROUP_HPP
+#define GPIO_GPIOMEM_GROUP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "group_base.hpp"
+
+#include <asio/io_service.hpp>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace gpiomem
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class chip;
+
+////////////////////////////////////////////////////////////////////////////////
+// pins are written through set/clear registers (one store per bank),
+// so that other pins in the bank are not affected
+class group : public group_base
+{
+public:
+    ////////////////////
+    group(asio::io_service&, gpiomem::chip*, std::vector<gpio::pos>,
+        gpio::mode, gpio::flag, mask
+    );
+    virtual ~group() override;
+
+    ////////////////////
+    using group_base::set;
+    virtual void set(mask values, mask lines) override;
+    virtual mask state() override;
+
+private:
+    ////////////////////
+    gpiomem::chip* mem_;
+
+    // banks spanned by the group
+    std::size_t bank_min_ = 0, bank_max_ = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
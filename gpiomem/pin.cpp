@@ -0,0 +1,161 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip.hpp"
+#include "pin.hpp"
+#include "type_id.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace gpiomem
+{
+
+////////////////////////////////////////////////////////////////////////////////
+pin::pin(asio::io_service& io, gpiomem::chip* chip, gpio::pos n) :
+    pin_base(io, chip, n), bank_(n / 32), bit_(std::uint32_t { 1 } << (n % 32))
+{
+    valid_modes_ = 1 << in | 1 << out;
+    valid_flags_ = active_low;
+    if(chip->map().pull) valid_flags_ |= pull_up | pull_down;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+pin::~pin() { detach(); }
+
+////////////////////////////////////////////////////////////////////////////////
+void pin::mode(gpio::mode mode, gpio::flag flags, gpio::state state)
+{
+    if(mode != in && mode != out) throw std::invalid_argument(
+        type_id(this) + ": Cannot set pin mode - Invalid mode: " + std::to_string(mode)
+    );
+
+    if((flags & ~valid_flags_) || ((flags & pull_up) && (flags & pull_down)))
+        throw std::invalid_argument(
+            type_id(this) + ": Cannot set pin mode - Invalid flag(s): " + std::to_string(flags)
+        );
+
+    if(mode == out)
+    {
+        // set level before switching to output
+        pin_base::mode(mode, flags, state);
+        pin_base::set(state);
+
+        std::error_code ec;
+        sync_state(ec);
+    }
+    else pin_base::mode(mode, flags, state);
+
+    mem()->pull(pos_, flags & (pull_up | pull_down));
+    mem()->fsel(pos_, mode);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin::detach()
+{
+    mode_ = detached;
+    flags_ = { };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin::set(gpio::state state)
+{
+    std::error_code ec;
+    set(state, ec);
+    if(ec) throw_error("Cannot set pin state", ec);
+}
+
+gpio::state pin::state()
+{
+    std::error_code ec;
+    auto state = this->state(ec);
+    if(ec) throw_error("Cannot get pin state", ec);
+    return state;
+}
+
+void pin::period(nsec period)
+{
+    std::error_code ec;
+    this->period(period, ec);
+    if(ec) throw_error("Cannot set pin period", ec);
+}
+
+void pin::pulse(nsec pulse)
+{
+    std::error_code ec;
+    this->pulse(pulse, ec);
+    if(ec) throw_error("Cannot set pin pulse", ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin::set(gpio::state state, std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return; }
+
+    pin_base::set(state);
+    sync_state(ec);
+}
+
+gpio::state pin::state(std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return off; }
+
+    ec.clear();
+    bool value = mem()->lev(bank_) & bit_;
+    return value != is(active_low) ? on : off;
+}
+
+void pin::period(nsec period, std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return; }
+
+    // no pwm: keep the previous settings if the new ones need it
+    auto period0 = period_, pulse0 = pulse_;
+    pin_base::period(period);
+    sync_state(ec);
+    if(ec) { period_ = period0; pulse_ = pulse0; }
+}
+
+void pin::pulse(nsec pulse, std::error_code& ec) noexcept
+{
+    if(is_detached()) { ec = detached_error(); return; }
+
+    // no pwm: keep the previous settings if the new ones need it
+    auto period0 = period_, pulse0 = pulse_;
+    pin_base::pulse(pulse);
+    sync_state(ec);
+    if(ec) { period_ = period0; pulse_ = pulse0; }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+gpiomem::chip* pin::mem() const noexcept
+{
+    return static_cast<gpiomem::chip*>(chip_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin::sync_state(std::error_code& ec) noexcept
+{
+    if(pulse_ != 0ns && pulse_ != period_)
+    {
+        ec = std::make_error_code(std::errc::operation_not_supported);
+        return;
+    }
+
+    ec.clear();
+    if((pulse_ != 0ns) != is(active_low))
+        mem()->set(bank_, bit_);
+    else mem()->clr(bank_, bit_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
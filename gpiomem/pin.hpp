@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GPIOMEM_PIN_HPP
+#define GPIO_GPIOMEM_PIN_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "pin_base.hpp"
+
+#include <asio/io_service.hpp>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace gpiomem
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class chip;
+
+////////////////////////////////////////////////////////////////////////////////
+// NB: registers provide no edge notifications,
+// so state callbacks are never invoked and edge counters stay at 0
+class pin : public pin_base
+{
+public:
+    ////////////////////
+    pin(asio::io_service&, gpiomem::chip*, gpio::pos);
+    virtual ~pin() override;
+
+    ////////////////////
+    virtual void mode(gpio::mode, gpio::flag, gpio::state) override;
+
+    virtual void detach() override;
+    virtual bool is_detached() const noexcept override { return mode_ == detached; }
+
+    ////////////////////
+    virtual void set(gpio::state = on) override;
+    virtual gpio::state state() override;
+
+    virtual void period(nsec) override;
+    virtual void pulse(nsec) override;
+
+    virtual void set(gpio::state, std::error_code&) noexcept override;
+    virtual gpio::state state(std::error_code&) noexcept override;
+    virtual void period(nsec, std::error_code&) noexcept override;
+    virtual void pulse(nsec, std::error_code&) noexcept override;
+
+private:
+    ////////////////////
+    std::size_t bank_;
+    std::uint32_t bit_;
+
+    gpiomem::chip* mem() const noexcept;
+
+    // write pulse_ to the pin (pwm is not supported)
+    void sync_state(std::error_code&) noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
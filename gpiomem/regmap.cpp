@@ -0,0 +1,75 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/regmap.hpp>
+
+#include <chrono>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+regmap bcm2835()
+{
+    regmap map;
+
+    map.size = 0xb4;
+    map.pins = 54;
+
+    map.fsel = 0x00 / 4; // GPFSEL0
+    map.fsel_bits = 3;
+    map.fsel_in = 0b000;
+    map.fsel_out = 0b001;
+
+    map.set = 0x1c / 4; // GPSET0
+    map.clr = 0x28 / 4; // GPCLR0
+    map.lev = 0x34 / 4; // GPLEV0
+
+    map.pull = [](volatile std::uint32_t* base, gpio::pos n, gpio::flag flag)
+    {
+        constexpr std::size_t pud = 0x94 / 4, pudclk = 0x98 / 4; // GPPUD, GPPUDCLK0
+
+        // control signal must be set up and held for 150 cycles
+        base[pud] = flag == pull_up ? 0b10 : flag == pull_down ? 0b01 : 0b00;
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+
+        base[pudclk + n / 32] = std::uint32_t { 1 } << (n % 32);
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+
+        base[pud] = 0;
+        base[pudclk + n / 32] = 0;
+    };
+
+    return map;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+regmap bcm2711()
+{
+    auto map = bcm2835();
+
+    map.size = 0xf4;
+    map.pins = 58;
+
+    map.pull = [](volatile std::uint32_t* base, gpio::pos n, gpio::flag flag)
+    {
+        constexpr std::size_t cntrl = 0xe4 / 4; // GPIO_PUP_PDN_CNTRL_REG0
+
+        auto reg = base + cntrl + n / 16;
+        auto shift = 2 * (n % 16);
+
+        std::uint32_t value = flag == pull_up ? 0b01 : flag == pull_down ? 0b10 : 0b00;
+        *reg = (*reg & ~(std::uint32_t { 0b11 } << shift)) | (value << shift);
+    };
+
+    return map;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
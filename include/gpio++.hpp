@@ -1,3 +1,11 @@
+#include <gpio++/bus.hpp>
 #include <gpio++/chip.hpp>
+#include <gpio++/encoder.hpp>
+#include <gpio++/group.hpp>
+#include <gpio++/i2c.hpp>
+#include <gpio++/onewire.hpp>
 #include <gpio++/pin.hpp>
+#include <gpio++/spi.hpp>
+#include <gpio++/timing.hpp>
 #include <gpio++/types.hpp>
+#include <gpio++/wave.hpp>
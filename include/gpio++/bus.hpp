@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_BUS_HPP
+#define GPIO_BUS_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/chip.hpp>
+#include <gpio++/group.hpp>
+#include <gpio++/types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// N-bit parallel bus (bit n <-> n-th pin)
+template<std::size_t N>
+class bus
+{
+    static_assert(N > 0 && N <= 64, "Bus width must be between 1 and 64");
+
+public:
+    ////////////////////
+    using value_type =
+        std::conditional_t<(N <= 8 ), std::uint8_t ,
+        std::conditional_t<(N <= 16), std::uint16_t,
+        std::conditional_t<(N <= 32), std::uint32_t, std::uint64_t>>>;
+
+    static constexpr std::size_t width() noexcept { return N; }
+
+    ////////////////////
+    bus(gpio::chip* chip, const std::array<gpio::pos, N>& pins,
+        gpio::mode mode = out, gpio::flag flags = { }, value_type value = 0
+    ) :
+        group_(chip->group(
+            std::vector<gpio::pos>(pins.begin(), pins.end()), mode, flags, value
+        ))
+    { }
+
+    ////////////////////
+    void set(value_type value) { group_->set(value); }
+    bus& operator=(value_type value) { set(value); return *this; }
+
+    value_type state() { return static_cast<value_type>(group_->state()); }
+
+    ////////////////////
+    gpio::group* group() noexcept { return group_.get(); }
+    const gpio::group* group() const noexcept { return group_.get(); }
+
+private:
+    ////////////////////
+    unique_group group_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -9,13 +9,17 @@
 #define GPIO_CHIP_HPP
 
 ////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/group.hpp>
 #include <gpio++/pin.hpp>
+#include <gpio++/timing.hpp>
 #include <gpio++/types.hpp>
 
 #include <asio/io_service.hpp>
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace gpio
@@ -37,12 +41,42 @@ struct chip
 
     virtual gpio::pin* pin(gpio::pos) = 0;
     virtual const gpio::pin* pin(gpio::pos) const = 0;
+
+    ////////////////////
+    // request pins as a group (bit n of mask <-> n-th pin)
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode, gpio::flag, mask) = 0;
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode, gpio::flag) = 0;
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode, mask) = 0;
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode) = 0;
+
+    ////////////////////
+    // timing of threads generating signals (eg, software pwm)
+    virtual void timing(const gpio::timing&) = 0;
+    virtual const gpio::timing& timing() const noexcept = 0;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 using unique_chip = std::unique_ptr<chip>;
 extern unique_chip get_chip(asio::io_service&, std::string param = "");
 
+////////////////////////////////////////////////////////////////////////////////
+// ids of all chips in the system (in the order of their id)
+extern std::vector<std::string> get_chip_ids();
+
+// location of a named line
+struct line_ref
+{
+    std::string chip; // chip id (see get_chip)
+    gpio::pos pos;
+};
+
+// line name -> location
+using line_index = std::unordered_map<std::string, line_ref>;
+
+// index of named lines in all chips
+// (if several lines have the same name, the first one is used)
+extern line_index get_line_index();
+
 ////////////////////////////////////////////////////////////////////////////////
 }
 
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_ENCODER_HPP
+#define GPIO_ENCODER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/chip.hpp>
+#include <gpio++/pin.hpp>
+#include <gpio++/types.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// quadrature rotary encoder
+//
+// Both pins are set up as inputs and their timestamped events are decoded in
+// the order they were received using a transition table. Every valid
+// transition counts as one step (4 steps per quadrature cycle), positive when
+// A leads B. Events repeating the previous level of a pin (ie, an edge was
+// lost) are counted as invalid and ignored.
+//
+// Events of both pins must be delivered in order, so the pins are detached
+// and requested together. The generic backend reads their events from one
+// line request, which holds both lines until both pins are detached (the
+// pins shouldn't be reconfigured while the encoder exists). The pigpio
+// backend reads each pin separately and the gpiomem backend has no events,
+// so they are rejected.
+//
+// Decoding is done on the io_service thread. Position, velocity and the
+// number of invalid transitions can be read from any thread.
+//
+class encoder
+{
+public:
+    ////////////////////
+    // velocity is measured over the given window
+    encoder(gpio::chip*, gpio::pos a, gpio::pos b,
+        gpio::flag = { }, nsec window = 100ms
+    );
+    ~encoder();
+
+    encoder(const encoder&) = delete;
+    encoder& operator=(const encoder&) = delete;
+
+    ////////////////////
+    std::int64_t position() const noexcept { return pos_.load(std::memory_order_relaxed); }
+    void position(std::int64_t pos) noexcept { pos_.store(pos, std::memory_order_relaxed); }
+    void reset() noexcept { position(0); }
+
+    // steps/sec (0 when stopped)
+    double velocity() const noexcept;
+
+    // number of invalid transitions
+    std::uint64_t invalid() const noexcept { return invalid_.load(std::memory_order_relaxed); }
+
+private:
+    ////////////////////
+    gpio::pin* a_;
+    gpio::pin* b_;
+    cid a_id_, b_id_;
+
+    nsec window_;
+
+    std::atomic<std::int64_t> pos_ { 0 };
+    std::atomic<std::uint64_t> invalid_ { 0 };
+    std::atomic<double> vel_ { 0 };
+    std::atomic<nsec::rep> last_ { 0 };
+
+    // current state (A << 1 | B)
+    unsigned state_ = 0;
+
+    // steps since the start of the velocity window & its time
+    // (not affected by position() or reset()), time of the last step
+    std::int64_t steps_ = 0;
+    timestamp time0_, time_;
+
+    void decode(unsigned bit, events);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_GROUP_HPP
+#define GPIO_GROUP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/types.hpp>
+#include <gpio++/wave.hpp>
+
+#include <cstddef>
+#include <memory>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+struct chip;
+
+////////////////////////////////////////////////////////////////////////////////
+// group of pins requested together and accessed as one
+struct group
+{
+    virtual ~group() { }
+
+    ////////////////////
+    virtual const gpio::chip* chip() const noexcept = 0;
+
+    // number of pins in the group
+    virtual std::size_t size() const noexcept = 0;
+    // pin # of the n-th pin in the group
+    virtual gpio::pos pos(std::size_t n) const = 0;
+
+    ////////////////////
+    virtual gpio::mode mode() const noexcept = 0;
+    virtual bool is(gpio::flag) const noexcept = 0;
+
+    ////////////////////
+    // digital (bit n <-> n-th pin)
+    virtual void set(mask) = 0;
+    // set only pins in lines
+    virtual void set(mask values, mask lines) = 0;
+    // read all pins at once
+    virtual mask state() = 0;
+
+    ////////////////////
+    // play waveform on a dedicated thread repeat times (0 = until stopped)
+    // and invoke the callback on the io_service when done (the callback is
+    // not invoked, if the waveform is stopped or fails to play)
+    virtual void play(gpio::wave, std::size_t repeat = 1, fn_done = nullptr) = 0;
+    virtual void stop() = 0;
+    virtual bool is_playing() const noexcept = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+using unique_group = std::unique_ptr<group>;
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
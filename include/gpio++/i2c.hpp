@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_I2C_HPP
+#define GPIO_I2C_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/chip.hpp>
+#include <gpio++/group.hpp>
+#include <gpio++/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class worker;
+
+////////////////////////////////////////////////////////////////////////////////
+// bit-banged i2c master
+//
+// SDA and SCL are requested once as an open-drain output group. Lines are
+// released or driven low and sampled without re-requesting them. Clock
+// stretching is supported. Each call is a complete transaction timed on
+// a dedicated thread using the chip timing options.
+//
+class i2c_bitbang
+{
+public:
+    ////////////////////
+    // extra flags (eg, pull_up) are added to open_drain
+    i2c_bitbang(gpio::chip*, gpio::pos sda, gpio::pos scl,
+        unsigned hz = 100000, gpio::flag = { }
+    );
+    ~i2c_bitbang();
+
+    ////////////////////
+    // max time a device can stretch the clock
+    void stretch(nsec timeout) noexcept { stretch_ = timeout; }
+    nsec stretch() const noexcept { return stretch_; }
+
+    ////////////////////
+    // throw std::runtime_error if not acknowledged
+    void write(std::uint8_t addr, const std::vector<std::uint8_t>&);
+    std::vector<std::uint8_t> read(std::uint8_t addr, std::size_t size);
+
+    // write, then read after repeated start (eg, register read)
+    std::vector<std::uint8_t> transfer(std::uint8_t addr,
+        const std::vector<std::uint8_t>&, std::size_t size
+    );
+
+    // returns true if device acknowledges its address
+    bool probe(std::uint8_t addr);
+
+private:
+    ////////////////////
+    unique_group lines_; // sda, scl
+    std::unique_ptr<worker> worker_;
+
+    const gpio::timing& timing_;
+    nsec half_, stretch_ = 10ms;
+
+    void delay();
+    void scl_release();
+
+    void start();
+    void stop();
+    void write_bit(bool);
+    bool read_bit();
+    bool write_byte(std::uint8_t);
+    std::uint8_t read_byte(bool ack);
+
+    void address(std::uint8_t addr, bool read);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
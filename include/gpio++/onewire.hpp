@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_ONEWIRE_HPP
+#define GPIO_ONEWIRE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/chip.hpp>
+#include <gpio++/group.hpp>
+#include <gpio++/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class worker;
+
+////////////////////////////////////////////////////////////////////////////////
+// bit-banged 1-Wire master
+//
+// The pin is requested once as open-drain output, which is released (driven
+// high by the pull-up) or driven low and sampled without re-requesting the
+// line. Each call is a complete transaction timed on a dedicated thread using
+// the chip timing options.
+//
+class onewire
+{
+public:
+    ////////////////////
+    using rom = std::uint64_t;
+
+    ////////////////////
+    // extra flags (eg, pull_up) are added to open_drain
+    onewire(gpio::chip*, gpio::pos, gpio::flag = { });
+    ~onewire();
+
+    ////////////////////
+    // reset pulse; returns true if any device is present
+    bool reset();
+
+    void write(const std::vector<std::uint8_t>&);
+    std::vector<std::uint8_t> read(std::size_t size);
+
+    // address device (or all devices) after reset
+    void select(rom);
+    void skip();
+
+    // find all devices on the bus (ROM search)
+    std::vector<rom> search();
+
+    // Dallas/Maxim CRC-8
+    static std::uint8_t crc8(const std::uint8_t*, std::size_t size) noexcept;
+
+private:
+    ////////////////////
+    unique_group line_;
+    std::unique_ptr<worker> worker_;
+
+    const gpio::timing& timing_;
+
+    bool reset_();
+    void write_bit(bool);
+    bool read_bit();
+    void write_byte(std::uint8_t);
+    std::uint8_t read_byte();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -13,6 +13,7 @@
 
 #include <set>
 #include <string>
+#include <system_error>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace gpio
@@ -67,14 +68,64 @@ struct pin
     virtual void duty_cycle(percent) = 0;
     virtual percent duty_cycle() const noexcept = 0;
 
+    // non-throwing versions of the above
+    virtual void set(gpio::state, std::error_code&) noexcept = 0;
+    virtual gpio::state state(std::error_code&) noexcept = 0;
+    virtual void period(nsec, std::error_code&) noexcept = 0;
+    virtual void pulse(nsec, std::error_code&) noexcept = 0;
+
+    // software pwm timing statistics
+    virtual pwm_stats stats() const = 0;
+
     ////////////////////
     // digital callback
     virtual cid on_state_changed(fn_state_changed) = 0;
     virtual cid on_state_on(fn_state_on) = 0;
     virtual cid on_state_off(fn_state_off) = 0;
 
+    // state & time it was captured
+    virtual cid on_edge(fn_edge) = 0;
+
+    // all events received at once
+    virtual cid on_events(fn_events) = 0;
+
     virtual bool remove(cid) = 0;
 
+    // only report transitions that remained stable
+    // for the given period of time (0 = disabled)
+    virtual void debounce(nsec) = 0;
+    virtual nsec debounce() const noexcept = 0;
+
+    ////////////////////
+    // edge counter & frequency meter
+    //
+    // Count edges and measure frequency of the input signal inside the
+    // backend without invoking callbacks for each edge. Frequency is measured
+    // over the given window (0 = stop counting). Restarting clears the count.
+    virtual void count(nsec window = 1s) = 0;
+    virtual nsec count() const noexcept = 0;
+
+    // current reading (can be called from any thread)
+    virtual gpio::counter counter() const noexcept = 0;
+
+    // periodic summary (every window)
+    virtual cid on_counter(fn_counter) = 0;
+
+    ////////////////////
+    // input capture
+    //
+    // Pair rising & falling edge timestamps inside the backend to measure
+    // pulse width, period and duty cycle of the input signal (eg, RC servo
+    // pwm or ultrasonic echo). Pulses are reported at the falling edge.
+    virtual void capture(bool = true) = 0;
+    virtual bool is_capturing() const noexcept = 0;
+
+    // last captured pulse (lock-free, can be called from any thread)
+    virtual gpio::capture captured() const noexcept = 0;
+
+    // every captured pulse
+    virtual cid on_capture(fn_capture) = 0;
+
     ////////////////////
     template<typename... Args>
     auto as(Args&&... args)
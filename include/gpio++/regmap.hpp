@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_REGMAP_HPP
+#define GPIO_REGMAP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/chip.hpp>
+#include <gpio++/types.hpp>
+
+#include <asio/io_service.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// gpio register map for the memory-mapped (gpiomem) backend
+//
+// Register offsets are in 32-bit words from the start of the mapped block.
+// Set, clear and level registers have one bit per pin (32 pins per register,
+// consecutive registers for the following pins).
+//
+struct regmap
+{
+    // size of the register block in bytes
+    std::size_t size;
+    // number of pins
+    gpio::pos pins;
+
+    // function select registers: bits per pin and input/output values
+    // (32 / fsel_bits pins per register)
+    std::size_t fsel;
+    unsigned fsel_bits;
+    std::uint32_t fsel_in, fsel_out;
+
+    // set, clear and level registers
+    std::size_t set, clr, lev;
+
+    // configure pull-up/down resistor (flag is pull_up, pull_down or none)
+    // optional, pull_up/pull_down flags are not supported if empty
+    std::function<void(volatile std::uint32_t* base, gpio::pos, gpio::flag)> pull;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// BCM2835/6/7 (Raspberry Pi 1-3)
+extern regmap bcm2835();
+// BCM2711 (Raspberry Pi 4)
+extern regmap bcm2711();
+
+////////////////////////////////////////////////////////////////////////////////
+// open memory-mapped chip (gpiomem backend only)
+// path can be an ordinary file used as stand-in registers
+extern unique_chip get_chip(asio::io_service&, std::string path, gpio::regmap);
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_SPI_HPP
+#define GPIO_SPI_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/chip.hpp>
+#include <gpio++/group.hpp>
+#include <gpio++/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// spi mode (clock polarity and phase)
+enum spi_mode
+{
+    spi_mode_0 = 0, // idle low,  sample on rising edge
+    spi_mode_1 = 1, // idle low,  sample on falling edge
+    spi_mode_2 = 2, // idle high, sample on falling edge
+    spi_mode_3 = 3, // idle high, sample on rising edge
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// bit-banged spi master
+//
+// Clock, MOSI and CS are requested as one output group, so that each clock
+// edge together with the data bit is a single write. MISO and CS are optional
+// (pass npos), which makes it usable as a shift-out engine for 74HC595 chains
+// with CS acting as the latch.
+//
+class spi_bitbang
+{
+public:
+    ////////////////////
+    spi_bitbang(gpio::chip*, gpio::pos sclk, gpio::pos mosi, gpio::pos miso = npos,
+        gpio::pos cs = npos, spi_mode = spi_mode_0
+    );
+
+    ////////////////////
+    void mode(spi_mode mode) { mode_ = mode; idle(); }
+    auto mode() const noexcept { return mode_; }
+
+    // send lsb first
+    void lsb_first(bool lsb) noexcept { lsb_ = lsb; }
+    bool lsb_first() const noexcept { return lsb_; }
+
+    // clock frequency in Hz (0 = as fast as possible)
+    void clock(unsigned hz) noexcept;
+    unsigned clock() const noexcept { return hz_; }
+
+    ////////////////////
+    // full-duplex transfer (tx or rx can be nullptr)
+    void transfer(const std::uint8_t* tx, std::uint8_t* rx, std::size_t size);
+
+    void write(const std::vector<std::uint8_t>& data)
+    { transfer(data.data(), nullptr, data.size()); }
+
+    std::vector<std::uint8_t> read(std::size_t size)
+    {
+        std::vector<std::uint8_t> data(size);
+        transfer(nullptr, data.data(), size);
+        return data;
+    }
+
+    std::vector<std::uint8_t> transfer(const std::vector<std::uint8_t>& data)
+    {
+        std::vector<std::uint8_t> rx(data.size());
+        transfer(data.data(), rx.data(), data.size());
+        return rx;
+    }
+
+private:
+    ////////////////////
+    gpio::chip* chip_;
+
+    unique_group out_; // sclk, mosi, cs
+    unique_group in_;  // miso
+
+    mask sclk_ = 0, mosi_ = 0, cs_ = 0;
+
+    spi_mode mode_;
+    bool lsb_ = false;
+
+    unsigned hz_ = 0;
+    nsec half_ = 0ns;
+
+    mask clk_idle() const noexcept { return (mode_ & 2) ? sclk_ : 0; }
+    void idle();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_STATIC_BUS_HPP
+#define GPIO_STATIC_BUS_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/bus.hpp>
+#include <gpio++/chip.hpp>
+#include <gpio++/group.hpp>
+#include <gpio++/types.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <linux/gpio.h>
+#include <sys/ioctl.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace generic
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// line request fd of a group created by the generic backend (-1 otherwise)
+extern int native_handle(gpio::group*) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////
+// N-bit parallel bus accessed directly through the line request fd
+//
+// Lines are requested by the chip as a group (see chip::group), after which
+// set() and state() are a single inlined ioctl with no virtual calls.
+// Requires the generic backend.
+//
+template<std::size_t N>
+class static_bus
+{
+public:
+    ////////////////////
+    using value_type = typename gpio::bus<N>::value_type;
+
+    static constexpr std::size_t width() noexcept { return N; }
+
+    ////////////////////
+    // take over group of N lines
+    explicit static_bus(unique_group group) : group_(std::move(group))
+    {
+        if(!group_ || group_->size() != N) throw std::invalid_argument(
+            "static_bus: Invalid group size"
+        );
+
+        fd_ = generic::native_handle(group_.get());
+        if(fd_ < 0) throw std::invalid_argument(
+            "static_bus: Group has no line request fd"
+        );
+    }
+
+    static_bus(gpio::chip* chip, const std::array<gpio::pos, N>& pins,
+        gpio::mode mode = out, gpio::flag flags = { }, value_type value = 0
+    ) :
+        static_bus(chip->group(
+            std::vector<gpio::pos>(pins.begin(), pins.end()), mode, flags, value
+        ))
+    { }
+
+    ////////////////////
+    void set(value_type value, std::error_code& ec) noexcept
+    {
+        gpio_v2_line_values values { };
+        values.mask = all;
+        values.bits = value & all;
+
+        control(GPIO_V2_LINE_SET_VALUES_IOCTL, values, ec);
+    }
+    void set(value_type value)
+    {
+        std::error_code ec;
+        set(value, ec);
+        if(ec) throw std::system_error(ec, "static_bus: Cannot set state");
+    }
+    static_bus& operator=(value_type value) { set(value); return *this; }
+
+    value_type state(std::error_code& ec) noexcept
+    {
+        gpio_v2_line_values values { };
+        values.mask = all;
+
+        control(GPIO_V2_LINE_GET_VALUES_IOCTL, values, ec);
+        return static_cast<value_type>(values.bits & all);
+    }
+    value_type state()
+    {
+        std::error_code ec;
+        auto value = state(ec);
+        if(ec) throw std::system_error(ec, "static_bus: Cannot get state");
+        return value;
+    }
+
+    ////////////////////
+    gpio::group* group() noexcept { return group_.get(); }
+    int native_handle() const noexcept { return fd_; }
+
+private:
+    ////////////////////
+    unique_group group_;
+    int fd_ = -1;
+
+    static constexpr mask all = N < 64 ? (mask { 1 } << N) - 1 : ~mask { 0 };
+
+    void control(unsigned long cmd, gpio_v2_line_values& values, std::error_code& ec) noexcept
+    {
+        if(::ioctl(fd_, cmd, &values) < 0)
+            ec = std::error_code(errno, std::system_category());
+        else ec.clear();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// single line accessed directly through the line request fd
+class static_line
+{
+public:
+    ////////////////////
+    explicit static_line(unique_group group) : bus_(std::move(group)) { }
+
+    static_line(gpio::chip* chip, gpio::pos pin,
+        gpio::mode mode = out, gpio::flag flags = { }, gpio::state value = off
+    ) :
+        bus_(chip, { pin }, mode, flags, value)
+    { }
+
+    ////////////////////
+    void set(gpio::state state, std::error_code& ec) noexcept { bus_.set(state, ec); }
+    void set(gpio::state state = on) { bus_.set(state); }
+    void reset() { set(off); }
+
+    gpio::state state(std::error_code& ec) noexcept { return bus_.state(ec) ? on : off; }
+    gpio::state state() { return bus_.state() ? on : off; }
+
+    ////////////////////
+    gpio::group* group() noexcept { return bus_.group(); }
+    int native_handle() const noexcept { return bus_.native_handle(); }
+
+private:
+    ////////////////////
+    static_bus<1> bus_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
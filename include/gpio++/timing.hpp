@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_TIMING_HPP
+#define GPIO_TIMING_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// options for threads generating time-critical signals (eg, software pwm)
+//
+// Trade CPU time for lower jitter: run with real-time priority on a dedicated
+// CPU, keep memory locked, and spin on the clock for the last stretch before
+// each deadline instead of relying on the OS to wake up on time.
+//
+struct timing
+{
+    // SCHED_FIFO priority 1..99 (0 = normal scheduling)
+    int priority = 0;
+
+    // run on this CPU only (-1 = any)
+    int cpu = -1;
+
+    // lock process memory with mlockall()
+    bool lock_memory = false;
+
+    // sleep until this much time before each deadline, then spin (0 = sleep)
+    nsec spin = 0ns;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
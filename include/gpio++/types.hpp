@@ -9,14 +9,18 @@
 #define GPIO_TYPES_HPP
 
 ////////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
-#include <map>
+#include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace gpio
@@ -80,6 +84,10 @@ enum state : bool { on = true, off = false };
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// group state bitmask (bit n <-> n-th pin in the group)
+using mask = std::uint64_t;
+
 ////////////////////////////////////////////////////////////////////////////////
 // pwm pin period & pulse
 using nsec = std::chrono::nanoseconds;
@@ -101,11 +109,106 @@ auto operator""_pc(unsigned long long pc) noexcept
 
 }
 
+// pwm timing statistics
+struct pwm_stats
+{
+    // number of edges generated
+    std::uint64_t edges = 0;
+
+    // number of whole periods skipped, because
+    // an edge was late by more than one period
+    std::uint64_t missed = 0;
+
+    // number of edges that could not be written
+    // (not counted in edges or lateness)
+    std::uint64_t failed = 0;
+
+    // edge lateness histogram:
+    // bucket n counts edges late by [2^n, 2^(n+1)) nsec,
+    // bucket 0 also counts edges that were on time and
+    // the last bucket counts everything above
+    std::array<std::uint64_t, 32> lateness { };
+    nsec max_lateness = 0ns;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// event timestamp
+//
+// events are stamped by the kernel (or by the backend) at the time they are
+// captured, and the timestamp is converted to std::chrono::steady_clock,
+// which can be compared with steady_clock::now()
+using timestamp = std::chrono::steady_clock::time_point;
+
+// digital event
+struct event
+{
+    gpio::state state;
+    gpio::timestamp time;
+};
+
+// range of events delivered together
+struct events
+{
+    const event* begin() const noexcept { return begin_; }
+    const event* end() const noexcept { return end_; }
+
+    std::size_t size() const noexcept { return static_cast<std::size_t>(end_ - begin_); }
+    bool empty() const noexcept { return begin_ == end_; }
+
+    const event& operator[](std::size_t n) const noexcept { return begin_[n]; }
+
+    const event* begin_;
+    const event* end_;
+};
+
+// edge counter reading
+struct counter
+{
+    // number of edges since counting started,
+    // including those missed by the backend
+    std::uint64_t edges = 0;
+    // number of edges dropped before they could be read
+    // (eg, kernel event buffer overflow)
+    std::uint64_t missed = 0;
+
+    // signal frequency (Hz) measured between
+    // rising edges over the counter window
+    double freq = 0;
+
+    // time of the last edge
+    gpio::timestamp time { };
+};
+
+// input capture reading (one pulse)
+struct capture
+{
+    // time the pin was on (between rising & falling edge)
+    nsec width { 0 };
+    // time between the last two rising edges (0 = unknown)
+    nsec period { 0 };
+    // time of the falling edge
+    gpio::timestamp time { };
+
+    percent duty_cycle() const noexcept
+    { return period.count() ? 100_pc * width.count() / period.count() : 0_pc; }
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // digital callback
 using fn_state_changed = std::function<void(state)>;
 using fn_state_on = std::function<void()>;
 using fn_state_off = std::function<void()>;
+using fn_edge = std::function<void(state, timestamp)>;
+using fn_events = std::function<void(events)>;
+
+// edge counter callback
+using fn_counter = std::function<void(counter)>;
+
+// input capture callback
+using fn_capture = std::function<void(capture)>;
+
+// completion callback
+using fn_done = std::function<void()>;
 
 ////////////////////////////////////////////////////////////////////////////////
 // call id
@@ -119,41 +222,162 @@ constexpr cid ncid = static_cast<cid>(-1);
 
 }
 
+// get unique call id (shared by all callback chains)
+inline cid get_cid()
+{
+    static std::atomic<cid> seed { 0 };
+    return seed++;
+}
+
 // callback chain
+//
+// Callbacks are stored by value in a contiguous array in the order they were
+// added (call ids are increasing). Each callback can have a filter, which is
+// matched against the one passed to call_if(), so that eg, state on/off
+// callbacks share the chain (and its order) with state changed callbacks,
+// but are skipped without a call for the other state.
+//
+// The array is immutable and replaced as a whole (copy-on-write) when
+// callbacks are added or removed. Dispatch takes no locks: it registers as
+// a reader and iterates over the current array. Replaced arrays are freed
+// once there are no readers left. Thus, callbacks can be added or removed
+// from any thread or from inside a callback. Removed callbacks may still be
+// called by a dispatch that was already in progress.
+//
 template<typename Fn>
 struct call_chain
 {
+    ////////////////////
+    using filter = unsigned;
+    static constexpr filter all = ~filter { 0 };
+
     ////////////////////
     call_chain() = default;
+    ~call_chain()
+    {
+        delete chain_.load();
+        reclaim();
+    }
 
-    call_chain(call_chain&&) = default;
-    call_chain& operator=(call_chain&&) = default;
+    call_chain(const call_chain&) = delete;
+    call_chain& operator=(const call_chain&) = delete;
 
     ////////////////////
     template<typename T>
-    cid add(T&& fn)
+    cid add(T&& fn, filter f = all)
     {
         cid id = get_cid();
-        chain_.emplace(id, std::forward<T>(fn));
+        entry e { id, f, Fn(std::forward<T>(fn)) };
+
+        update([&](entries& chain){ chain.push_back(std::move(e)); return true; });
         return id;
     }
-    bool remove(cid id) { return chain_.erase(id); }
+    bool remove(cid id)
+    {
+        return update([&](entries& chain)
+        {
+            auto ri = std::find_if(chain.begin(), chain.end(),
+                [&](const entry& e){ return e.id == id; }
+            );
+            if(ri == chain.end()) return false;
+
+            chain.erase(ri);
+            return true;
+        });
+    }
 
     template<typename... Args>
-    void operator()(Args&&... args)
+    void operator()(const Args&... args)
     {
-        for(const auto& fn : chain_) fn.second(std::forward<Args>(args)...);
+        reader r { this };
+        if(r.chain) for(const auto& e : *r.chain) e.fn(args...);
+    }
+
+    // invoke callbacks whose filter matches f
+    template<typename... Args>
+    void call_if(filter f, const Args&... args)
+    {
+        reader r { this };
+        if(r.chain) for(const auto& e : *r.chain) if(e.f & f) e.fn(args...);
+    }
+
+    bool empty() const noexcept
+    {
+        auto chain = chain_.load();
+        return !chain || chain->empty();
     }
 
 private:
     ////////////////////
-    // get unique call id
-    static cid get_cid()
+    struct entry
+    {
+        cid id;
+        filter f;
+        Fn fn;
+    };
+    using entries = std::vector<entry>;
+
+    std::atomic<const entries*> chain_ { nullptr };
+    std::atomic<unsigned> readers_ { 0 };
+
+    // writers are serialized and keep replaced arrays until there are no readers
+    std::mutex mutex_;
+    std::vector<const entries*> retired_;
+    std::atomic<bool> pending_ { false };
+
+    ////////////////////
+    struct reader
+    {
+        call_chain* cc;
+        const entries* chain;
+
+        explicit reader(call_chain* cc) : cc(cc)
+        {
+            ++cc->readers_;
+            chain = cc->chain_.load();
+        }
+        ~reader()
+        {
+            if(--cc->readers_ == 0 && cc->pending_)
+            {
+                std::lock_guard<std::mutex> lock { cc->mutex_ };
+                if(cc->readers_ == 0) cc->reclaim();
+            }
+        }
+    };
+
+    // copy, modify and swap in the array
+    template<typename Op>
+    bool update(Op op)
+    {
+        std::lock_guard<std::mutex> lock { mutex_ };
+
+        auto chain = chain_.load();
+        auto next = chain ? new entries(*chain) : new entries;
+        if(!op(*next))
+        {
+            delete next;
+            return false;
+        }
+
+        chain_ = next;
+        if(chain)
+        {
+            retired_.push_back(chain);
+            pending_ = true;
+        }
+        if(readers_ == 0) reclaim();
+
+        return true;
+    }
+
+    // free replaced arrays (must be called with no readers)
+    void reclaim()
     {
-        static std::atomic<cid> seed { 0 };
-        return seed++;
+        for(auto chain : retired_) delete chain;
+        retired_.clear();
+        pending_ = false;
     }
-    std::map<cid, Fn> chain_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
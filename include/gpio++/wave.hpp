@@ -0,0 +1,84 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_WAVE_HPP
+#define GPIO_WAVE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <gpio++/types.hpp>
+
+#include <initializer_list>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// waveform step (bit n <-> n-th pin of the group)
+struct step
+{
+    mask lines;     // pins to update
+    mask values;    // their new values
+    nsec delay;     // wait before the next step
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// precompiled waveform
+//
+// Steps are converted into a list of writes at fixed offsets from the start
+// of the waveform. Consecutive steps without delay are merged into one write.
+//
+class wave
+{
+public:
+    ////////////////////
+    struct write
+    {
+        nsec time;      // offset from the start
+        mask lines, values;
+    };
+
+    ////////////////////
+    wave() = default;
+    wave(std::initializer_list<step> steps) { for(const auto& s : steps) add(s); }
+
+    template<typename It>
+    wave(It first, It last) { for(; first != last; ++first) add(*first); }
+
+    ////////////////////
+    wave& add(const step& s)
+    {
+        if(writes_.size() && writes_.back().time == duration_)
+        {
+            auto& wr = writes_.back();
+            wr.values = (wr.values & ~s.lines) | (s.values & s.lines);
+            wr.lines |= s.lines;
+        }
+        else writes_.push_back(write { duration_, s.lines, s.values & s.lines });
+
+        duration_ += s.delay;
+        return *this;
+    }
+
+    ////////////////////
+    const std::vector<write>& writes() const noexcept { return writes_; }
+    nsec duration() const noexcept { return duration_; }
+
+    bool empty() const noexcept { return writes_.empty(); }
+
+private:
+    ////////////////////
+    std::vector<write> writes_;
+    nsec duration_ = 0ns;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
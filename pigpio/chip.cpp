@@ -6,9 +6,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 #include "chip.hpp"
+#include "group.hpp"
 #include "pin.hpp"
 #include "type_id.hpp"
 
+#include <memory>
 #include <stdexcept>
 #include <utility>
 
@@ -21,14 +23,13 @@ namespace pigpio
 {
 
 ////////////////////////////////////////////////////////////////////////////////
-chip::chip(asio::io_service& io) : chip_base("pigpio")
+chip::chip(asio::io_service& io) : chip_base("pigpio"), io_(io)
 {
     if(gpioInitialise() < 0) throw std::runtime_error(
         type_id(this) + ": Error initializing pigpio library"
     );
 
-    for(gpio::pos n = 0; n < 32; ++n)
-        pins_.emplace_back(new pigpio::pin(io, this, n));
+    pins_.resize(32);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -38,6 +39,18 @@ chip::~chip()
     gpioTerminate();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+chip::unique_pin chip::make_pin(gpio::pos n)
+{
+    return std::make_unique<pigpio::pin>(io_, this, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+unique_group chip::group(std::vector<gpio::pos> pos, gpio::mode mode, gpio::flag flag, mask value)
+{
+    return std::make_unique<pigpio::group>(io_, this, std::move(pos), mode, flag, value);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 }
 
@@ -47,5 +60,11 @@ unique_chip get_chip(asio::io_service& io, std::string)
     return std::make_unique<pigpio::chip>(io);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> get_chip_ids() { return { "0" }; }
+
+// pigpio lines have no names
+line_index get_line_index() { return { }; }
+
 ////////////////////////////////////////////////////////////////////////////////
 }
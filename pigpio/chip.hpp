@@ -13,6 +13,7 @@
 
 #include <asio/io_service.hpp>
 #include <string>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace gpio
@@ -27,6 +28,16 @@ public:
     ////////////////////
     chip(asio::io_service&);
     virtual ~chip() override;
+
+    ////////////////////
+    using chip_base::group;
+    virtual unique_group group(std::vector<gpio::pos>, gpio::mode, gpio::flag, mask) override;
+
+private:
+    ////////////////////
+    asio::io_service& io_;
+
+    virtual unique_pin make_pin(gpio::pos) override;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
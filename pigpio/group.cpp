@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "chip.hpp"
+#include "group.hpp"
+#include "type_id.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <pigpio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace pigpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+group::group(asio::io_service& io, pigpio::chip* chip, std::vector<gpio::pos> pos,
+    gpio::mode mode, gpio::flag flag, mask value
+) :
+    group_base(io, chip, std::move(pos))
+{
+    unsigned pud;
+    switch(flag & ~open_drain)
+    {
+    case pull_up  : pud = PI_PUD_UP  ; break;
+    case pull_down: pud = PI_PUD_DOWN; break;
+
+    default:
+        if(flag & ~open_drain) throw std::invalid_argument(
+            type_id(this) + ": Cannot set group mode - Invalid flag: " + std::to_string(flag)
+        );
+        pud = PI_PUD_OFF;
+    }
+    flags_ = flag;
+
+    switch(mode)
+    {
+    case in:
+        if(flag & open_drain) throw std::invalid_argument(
+            type_id(this) + ": Cannot set group mode - Invalid flag: " + std::to_string(flag)
+        );
+        for(auto n : pos_)
+            if(gpioSetMode(static_cast<unsigned>(n), PI_INPUT) < 0
+                || gpioSetPullUpDown(static_cast<unsigned>(n), pud) < 0)
+            throw std::runtime_error(
+                type_id(this) + ": Cannot set group as input"
+            );
+        break;
+
+    case out:
+        if(flag & open_drain)
+        {
+            // pins are driven low by switching them to output
+            if(gpioWrite_Bits_0_31_Clear(to_bits(all())) < 0) throw std::runtime_error(
+                type_id(this) + ": Cannot set group as output"
+            );
+            for(auto n : pos_)
+                if(gpioSetPullUpDown(static_cast<unsigned>(n), pud) < 0) throw std::runtime_error(
+                    type_id(this) + ": Cannot set group as output"
+                );
+            set(value);
+            break;
+        }
+
+        set(value);
+        for(auto n : pos_)
+            if(gpioSetMode(static_cast<unsigned>(n), PI_OUTPUT) < 0
+                || gpioSetPullUpDown(static_cast<unsigned>(n), pud) < 0)
+            throw std::runtime_error(
+                type_id(this) + ": Cannot set group as output"
+            );
+        break;
+
+    default:
+        throw std::invalid_argument(
+            type_id(this) + ": Cannot set group mode - Invalid mode: " + std::to_string(mode)
+        );
+    }
+
+    mode_ = mode;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+group::~group() { stop(); }
+
+////////////////////////////////////////////////////////////////////////////////
+void group::set(mask values, mask lines)
+{
+    if(is(open_drain))
+    {
+        // release high pins (input) and drive low ones (output)
+        for(std::size_t n = 0; n < pos_.size(); ++n)
+            if(lines & (mask { 1 } << n) && gpioSetMode(static_cast<unsigned>(pos_[n]),
+                values & (mask { 1 } << n) ? PI_INPUT : PI_OUTPUT) < 0)
+            throw std::runtime_error(
+                type_id(this) + ": Cannot set group state"
+            );
+        return;
+    }
+
+    auto clr = to_bits(lines & ~values), set = to_bits(lines & values);
+
+    // the bank has separate clear and set registers, so lines going low
+    // change slightly before those going high (see group.hpp);
+    // skip the write that has nothing to do
+    if((clr && gpioWrite_Bits_0_31_Clear(clr) < 0)
+        || (set && gpioWrite_Bits_0_31_Set(set) < 0))
+    throw std::runtime_error(
+        type_id(this) + ": Cannot set group state"
+    );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+mask group::state()
+{
+    return to_mask(gpioRead_Bits_0_31());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t group::to_bits(mask value) const noexcept
+{
+    std::uint32_t bits = 0;
+    for(std::size_t n = 0; n < pos_.size(); ++n)
+        if(value & (mask { 1 } << n)) bits |= std::uint32_t { 1 } << pos_[n];
+    return bits;
+}
+
+mask group::to_mask(std::uint32_t bits) const noexcept
+{
+    mask value = 0;
+    for(std::size_t n = 0; n < pos_.size(); ++n)
+        if(bits & (std::uint32_t { 1 } << pos_[n])) value |= mask { 1 } << n;
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2018 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef GPIO_PIGPIO_GROUP_HPP
+#define GPIO_PIGPIO_GROUP_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "group_base.hpp"
+
+#include <asio/io_service.hpp>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace gpio
+{
+namespace pigpio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+class chip;
+
+////////////////////////////////////////////////////////////////////////////////
+// pins are written through the bank 0 clear and set registers: set() first
+// clears the lines going low and then sets the lines going high, so the two
+// sets of lines change one register write apart (there is no single write
+// driving some lines low and others high); lines changing in the same
+// direction change together
+class group : public group_base
+{
+public:
+    ////////////////////
+    group(asio::io_service&, pigpio::chip*, std::vector<gpio::pos>,
+        gpio::mode, gpio::flag, mask
+    );
+    virtual ~group() override;
+
+    ////////////////////
+    using group_base::set;
+    virtual void set(mask values, mask lines) override;
+    virtual mask state() override;
+
+private:
+    ////////////////////
+    // convert group mask to/from gpio bank bits
+    std::uint32_t to_bits(mask) const noexcept;
+    mask to_mask(std::uint32_t bits) const noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
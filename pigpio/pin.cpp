@@ -11,6 +11,10 @@
 
 #include <algorithm>
 #include <asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
 
 #include <fcntl.h>
 #include <pigpio.h>
@@ -23,19 +27,36 @@ namespace gpio
 namespace pigpio
 {
 
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// max number of reports drained with one read
+constexpr std::size_t events_max = 64;
+
+// pigpio error codes are not errno values
+std::error_code pigpio_error() noexcept
+{ return std::make_error_code(std::errc::io_error); }
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 pin::pin(asio::io_service& io, pigpio::chip* chip, gpio::pos n) :
-    pin_base(chip, n), fd_(io), buffer_(sizeof(gpioReport_t))
+    pin_base(io, chip, n), fd_(io), buffer_(events_max * sizeof(gpioReport_t))
 {
-    valid_modes_ = { in, out };
-    valid_flags_ = { pull_up, pull_down };
+    events_buf_.reserve(events_max);
+
+    valid_modes_ = 1 << in | 1 << out;
+    valid_flags_ = pull_up | pull_down;
 
     if(gpioSetPWMrange(to_gpio(), PI_MAX_DUTYCYCLE_RANGE) < 0)
         throw std::runtime_error(
             type_id(this) + ": Cannot set PWM range"
         );
 
-    get_period();
+    std::error_code ec;
+    get_period(ec);
+    if(ec) throw_error("Cannot get PWM frequency", ec);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -117,50 +138,100 @@ void pin::detach()
 ////////////////////////////////////////////////////////////////////////////////
 void pin::set(gpio::state state)
 {
-    if(gpioWrite(to_gpio(), state) < 0) throw std::runtime_error(
-        type_id(this) + ": Cannot set pin state"
-    );
-    pin_base::set(state);
+    std::error_code ec;
+    set(state, ec);
+    if(ec) throw_error("Cannot set pin state", ec);
 }
 
-////////////////////////////////////////////////////////////////////////////////
 gpio::state pin::state()
+{
+    std::error_code ec;
+    auto state = this->state(ec);
+    if(ec) throw_error("Cannot get pin state", ec);
+    return state;
+}
+
+void pin::period(nsec period)
+{
+    std::error_code ec;
+    this->period(period, ec);
+    if(ec) throw_error("Cannot set PWM frequency", ec);
+}
+
+void pin::pulse(nsec pulse)
+{
+    std::error_code ec;
+    this->pulse(pulse, ec);
+    if(ec) throw_error("Cannot set PWM duty cycle", ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin::set(gpio::state state, std::error_code& ec) noexcept
+{
+    if(gpioWrite(to_gpio(), state) < 0) { ec = pigpio_error(); return; }
+
+    pin_base::set(state);
+    ec.clear();
+}
+
+gpio::state pin::state(std::error_code& ec) noexcept
 {
     auto value = gpioRead(to_gpio());
-    if(value < 0) throw std::runtime_error(
-        type_id(this) + ": Cannot get pin state"
-    );
+    if(value < 0) { ec = pigpio_error(); return off; }
 
+    ec.clear();
     return value ? on : off;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-void pin::period(nsec period)
+void pin::period(nsec period, std::error_code& ec) noexcept
 {
     pin_base::period(period);
 
     auto freq = nsec::period::den / (nsec::period::num * period_.count());
     if(gpioSetPWMfrequency(to_gpio(), static_cast<unsigned>(freq)) < 0)
-        throw std::runtime_error(
-            type_id(this) + ": Cannot set PWM frequency"
-        );
+    {
+        ec = pigpio_error();
+        return;
+    }
 
-    get_period();
-    get_pulse();
+    get_period(ec);
+    if(!ec) get_pulse(ec);
 }
 
-////////////////////////////////////////////////////////////////////////////////
-void pin::pulse(nsec pulse)
+void pin::pulse(nsec pulse, std::error_code& ec) noexcept
 {
     pin_base::pulse(pulse);
 
     auto cycle = pulse_ * PI_MAX_DUTYCYCLE_RANGE / period_;
     if(gpioPWM(to_gpio(), static_cast<unsigned>(cycle)) < 0)
+    {
+        ec = pigpio_error();
+        return;
+    }
+
+    get_pulse(ec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pin::debounce(nsec time)
+{
+    pin_base::debounce(time);
+
+    // use glitch filter if within its range,
+    // otherwise fall back to software debounce
+    auto usec = (debounce_.count() + 999) / 1000;
+    if(usec <= PI_MAX_STEADY)
+    {
+        if(gpioGlitchFilter(to_gpio(), static_cast<unsigned>(usec)) < 0)
+            throw std::runtime_error(
+                type_id(this) + ": Cannot set glitch filter"
+            );
+        sw_debounce_ = 0ns;
+    }
+    else if(gpioGlitchFilter(to_gpio(), 0) < 0)
         throw std::runtime_error(
-            type_id(this) + ": Cannot set PWM duty cycle"
+            type_id(this) + ": Cannot clear glitch filter"
         );
-
-    get_pulse();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -180,6 +251,7 @@ void pin::attach()
         type_id(this) + ": Error opening file " + path + " - " + ec.message()
     );
 
+    size_ = 0;
     if(gpioNotifyBegin(static_cast<unsigned>(handle_), 1 << pos_) < 0)
         throw std::runtime_error(
             type_id(this) + ": Cannot start notification"
@@ -190,38 +262,55 @@ void pin::attach()
 ////////////////////////////////////////////////////////////////////////////////
 void pin::sched_read()
 {
-    asio::async_read(fd_, asio::buffer(buffer_),
-        [&](const asio::error_code& ec, std::size_t)
+    fd_.async_read_some(asio::buffer(buffer_.data() + size_, buffer_.size() - size_),
+        [&](const asio::error_code& ec, std::size_t size)
         {
             if(ec) return;
+            size_ += size;
 
-            auto ev = reinterpret_cast<gpioReport_t*>(buffer_.data());
-            state_changed_(ev->level & (1 << pos_) ? on : off);
+            auto ev = reinterpret_cast<const gpioReport_t*>(buffer_.data());
+            auto end = ev + size_ / sizeof(gpioReport_t);
 
+            // reports are stamped with pigpio tick (usec, wraps every ~72 min)
+            auto now = std::chrono::steady_clock::now();
+            auto tick = gpioTick();
+
+            events_buf_.clear();
+            for(; ev != end; ++ev) events_buf_.push_back(event {
+                ev->level & (1 << pos_) ? on : off,
+                now - std::chrono::microseconds(static_cast<std::uint32_t>(tick - ev->tick))
+            });
+
+            // keep partial report for the next read
+            auto used = events_buf_.size() * sizeof(gpioReport_t);
+            std::copy(buffer_.begin() + used, buffer_.begin() + size_, buffer_.begin());
+            size_ -= used;
+
+            dispatch(events_buf_.data(), events_buf_.data() + events_buf_.size());
             sched_read();
         }
     );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::get_period()
+void pin::get_period(std::error_code& ec) noexcept
 {
     auto freq = gpioGetPWMfrequency(to_gpio());
-    if(freq < 0) throw std::runtime_error(
-        type_id(this) + ": Cannot get PWM frequency"
-    );
+    if(freq < 0) { ec = pigpio_error(); return; }
+
     period_ = nsec(nsec::period::den / (nsec::period::num * freq));
+    ec.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void pin::get_pulse()
+void pin::get_pulse(std::error_code& ec) noexcept
 {
+    ec.clear();
     if(pulse_ != 0ns)
     {
         auto cycle = gpioGetPWMdutycycle(to_gpio());
-        if(cycle < 0) throw std::runtime_error(
-            type_id(this) + ": Cannot get PWM duty cycle"
-        );
+        if(cycle < 0) { ec = pigpio_error(); return; }
+
         pulse_ = period_ * cycle / PI_MAX_DUTYCYCLE_RANGE;
     }
 }
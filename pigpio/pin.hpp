@@ -13,6 +13,7 @@
 
 #include <asio/io_service.hpp>
 #include <asio/posix/stream_descriptor.hpp>
+#include <cstddef>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +49,14 @@ public:
     virtual void period(nsec) override;
     virtual void pulse(nsec) override;
 
+    virtual void set(gpio::state, std::error_code&) noexcept override;
+    virtual gpio::state state(std::error_code&) noexcept override;
+    virtual void period(nsec, std::error_code&) noexcept override;
+    virtual void pulse(nsec, std::error_code&) noexcept override;
+
+    ////////////////////
+    virtual void debounce(nsec) override;
+
 private:
     ////////////////////
     int handle_ = -1;
@@ -56,13 +65,16 @@ private:
     void attach();
 
     std::vector<char> buffer_;
+    std::size_t size_ = 0;
+
+    std::vector<event> events_buf_;
     void sched_read();
 
     ////////////////////
     auto to_gpio() const noexcept { return static_cast<unsigned>(pos_); }
 
-    void get_period();
-    void get_pulse();
+    void get_period(std::error_code&) noexcept;
+    void get_pulse(std::error_code&) noexcept;
 };
 
 ////////////////////////////////////////////////////////////////////////////////